@@ -14,10 +14,16 @@
 #include <assert.h>  /* assert */
 #include <stdbool.h> /* true, false */
 #include <stdint.h>  /* uint8_t, uint32_t */
-#include <stdio.h>   /* FILE, ftell, fopen, rewind, fseek, fprintf,  ... */
-#include <stdlib.h>  /* malloc, EXIT_SUCCESS */
+#include <stdio.h>   /* FILE, fopen, fclose, fprintf, remove, ... */
+#include <stdlib.h>  /* strtoull, EXIT_SUCCESS */
+#include <string.h>  /* strcmp */
 
 #include "rle.h"
+#include "rle_file.h"
+#include "rle_io.h"
+#ifndef _WIN32
+#include "rle_direct.h"
+#endif
 
 /* Private typedef -----------------------------------------------------------*/
 /*! The Config struct contains information about current run configuration based
@@ -30,11 +36,23 @@ struct Config {
   /*! Path to output file. */
   char* outputFileName;
 
+  /*! Memory budget of chunked processing, zero to process whole file. */
+  uint64_t maxMemory;
+
+  /*! Decoded data are written with O_DIRECT, bypassing the page cache. */
+  bool direct;
+
   /*! Structure for desired action. */
   struct Action {
     /*! Pointer to effective function that do the RLE action
-     * (encoding/decoding). */
-    RLE_State (*fnc)(const uint8_t*, uint32_t, RLE_Data*);
+     * (encoding/decoding) between the input source and the output sink. */
+    RLE_State (*ioFnc)(const RLE_Source*, const RLE_Sink*, uint64_t*,
+                       uint64_t*);
+
+    /*! Pointer to function that processes the input file in chunks within
+     * the memory budget. */
+    RLE_State (*chunkedFnc)(FILE*, FILE*, const RLE_FileOptions*, uint64_t*,
+                            uint64_t*);
 
     /*! Message for error state. */
     const char* errMsg;
@@ -64,57 +82,37 @@ struct Config {
 
 /*! \}*/
 
-/*! Allocation step for file loading. */
-#define ALLOC_STEP (0x400)
-
 /* Private variables ---------------------------------------------------------*/
 
 /* Private function declarations ---------------------------------------------*/
 static bool parseArgs(int argc, char** argv, struct Config* cfg);
+static bool parseSize(const char* text, uint64_t* size);
+static int runStreamed(const struct Config* cfg);
+static int runChunked(const struct Config* cfg);
 static void printHelp(char* bin);
-static int loadFileData(char* fileName, RLE_Data* fileData);
+#ifndef _WIN32
+static int runDirect(const struct Config* cfg);
+#endif
 
 /* Exported functions definitions --------------------------------------------*/
 int main(int argc, char** argv) {
   int programResult = EXIT_SUCCESS;
   struct Config cfg;
-  struct Action* action = &cfg.rleAction;
   if (!parseArgs(argc, argv, &cfg)) {
     programResult = EXIT_FAILURE_ARGUMENTS;
     goto exit;
   }
 
-  // load input data
-  RLE_Data in = {NULL, 0};
-  if ((programResult = loadFileData(cfg.inputFileName, &in)) != 0) {
-    goto exit;
-  }
-
-  // do RLE action
-  RLE_Data result = {NULL, 0};
-  bool rleSuccessful = action->fnc(in.data, in.size, &result) == RLE_OK;
-  free(in.data);  // free data as soon as possible
-
-  // exit when RLE was not successful
-  if (rleSuccessful == false) {
-    fprintf(stderr, "Error while %s\n", action->errMsg);
-    programResult = EXIT_RLE_ERROR;
-    goto exit;
-  }
-
-  fprintf(stdout, "%s done\nCompression ratio: %f %%\n", action->okMSg,
-          (double)in.size / result.size);
-  FILE* of = fopen(cfg.outputFileName, "wb");
-
-  if (of == NULL) {
-    programResult = EXIT_FAILURE_FILE;
-  } else if (fwrite(result.data, 1, result.size, of) != result.size) {
-    fprintf(stderr, "Error writing output. Error '%d'", ferror(of));
+  if (cfg.maxMemory != 0) {
+    programResult = runChunked(&cfg);
+#ifndef _WIN32
+  } else if (cfg.direct) {
+    programResult = runDirect(&cfg);
+#endif
+  } else {
+    programResult = runStreamed(&cfg);
   }
 
-  free(result.data);
-  fclose(of);
-
 exit:
   return programResult;
 }
@@ -132,8 +130,34 @@ exit:
  */
 static bool parseArgs(int argc, char** argv, struct Config* cfg) {
   assert(cfg != NULL);
+  char* bin = argv[0];
+
+  cfg->maxMemory = 0;
+  cfg->direct = false;
+  while (argc > 4 && strncmp(argv[1], "--", 2) == 0) {
+    if (strcmp(argv[1], "--max-memory") == 0 && argc > 5) {
+      if (!parseSize(argv[2], &cfg->maxMemory) || cfg->maxMemory == 0) {
+        fprintf(stderr, "Wrong memory size '%s'\n", argv[2]);
+        printHelp(bin);
+        return false;
+      }
+      argc -= 2;
+      argv += 2;
+#ifndef _WIN32
+    } else if (strcmp(argv[1], "--direct") == 0) {
+      cfg->direct = true;
+      argc--;
+      argv++;
+#endif
+    } else {
+      fprintf(stderr, "Unknown option '%s'\n", argv[1]);
+      printHelp(bin);
+      return false;
+    }
+  }
+
   if (argc != 4) {
-    printHelp(argv[0]);
+    printHelp(bin);
     return false;
   }
 
@@ -141,19 +165,69 @@ static bool parseArgs(int argc, char** argv, struct Config* cfg) {
   cfg->outputFileName = argv[3];
 
   if (argv[2][0] == 'd') {
-    cfg->rleAction.fnc = RLE_decode;
+    cfg->rleAction.ioFnc = RLE_decode_io;
+    cfg->rleAction.chunkedFnc = RLE_decode_file;
     cfg->rleAction.errMsg = "decoding";
     cfg->rleAction.okMSg = "Decode";
   } else if (argv[2][0] == 'e') {
-    cfg->rleAction.fnc = RLE_encode;
+    cfg->rleAction.ioFnc = RLE_encode_io;
+    cfg->rleAction.chunkedFnc = RLE_encode_file;
     cfg->rleAction.errMsg = "encoding";
     cfg->rleAction.okMSg = "Encode";
   } else {
     fprintf(stderr, "Unknown value '%s'\n", argv[2]);
-    printHelp(argv[0]);
+    printHelp(bin);
+    return false;
+  }
+
+  if (cfg->direct && (argv[2][0] != 'd' || cfg->maxMemory != 0)) {
+    fputs("Option --direct is supported for whole file decoding only\n",
+          stderr);
+    return false;
+  }
+
+  return true;
+}
+
+/*! Parses the size in bytes with optional K, M or G suffix.
+ *
+ * \param[in]  text  Parsed text.
+ * \param[out] size  Parsed size.
+ *
+ * \return Returns true if the text is a valid size, false otherwise.
+ */
+static bool parseSize(const char* text, uint64_t* size) {
+  char* end;
+  unsigned long long value = strtoull(text, &end, 10);
+  unsigned shift = 0;
+
+  if (end == text || text[0] == '-') {
+    return false;
+  }
+
+  switch (*end) {
+    case 'K':
+      shift = 10;
+      break;
+    case 'M':
+      shift = 20;
+      break;
+    case 'G':
+      shift = 30;
+      break;
+    case '\0':
+      break;
+    default:
+      return false;
+  }
+  if (shift != 0 && *++end != '\0') {
+    return false;
+  }
+  if (value > UINT64_MAX >> shift) {
     return false;
   }
 
+  *size = (uint64_t)value << shift;
   return true;
 }
 
@@ -165,70 +239,158 @@ static void printHelp(char* bin) {
   assert(bin != NULL);
   fprintf(stderr,
           "Wrong call\n"
-          "Usage %s <input file> <type> <output file>\n"
+          "Usage %s [options] <input file> <type> <output file>\n"
+          "\toptions:\n"
+          "\t\t--max-memory <size> - process file in chunks within the\n"
+          "\t\t                      memory budget, K, M or G suffix\n"
+          "\t\t--direct            - decode bypassing the page cache\n"
           "\ttype:\n"
           "\t\td - decode file\n"
           "\t\te - encode file\n",
           bin);
 }
 
-/*! Load content of the file to the dynamically allocated memory.
+/*! Streams the whole input file through the RLE action to the output file.
+ * The codec reads and writes the files through its own buffers, so neither
+ * the input nor the result is loaded to memory at once.
  *
- * \param[in] fileName    Name of file to load.
- * \param[out] fileData   Pointer to the loaded data structure.
+ * \param[in] cfg   Pointer to structure with configuration.
  *
  * \return Returns non-zero value on error.
  */
-static int loadFileData(char* fileName, RLE_Data* fileData) {
-  assert(fileName != NULL);
-  assert(fileData != NULL);
-
-  int ret = EXIT_SUCCESS;
-  size_t allocated = ALLOC_STEP;
-  size_t readBytes;
-  uint8_t* pFileContent;
-  FILE* file;
-
-  fileData->data = malloc(ALLOC_STEP);
-  if (fileData->data == NULL) {
-    ret = EXIT_FAILURE_MEMORY;
-    goto exit;
+static int runStreamed(const struct Config* cfg) {
+  assert(cfg != NULL);
+  const struct Action* action = &cfg->rleAction;
+  RLE_Source source;
+  RLE_Sink sink;
+  uint64_t read = 0;
+  uint64_t written = 0;
+
+  FILE* in = fopen(cfg->inputFileName, "rb");
+  if (in == NULL) {
+    return EXIT_FAILURE_FILE;
   }
 
-  pFileContent = fileData->data;
+  FILE* of = fopen(cfg->outputFileName, "wb");
+  if (of == NULL) {
+    fclose(in);
+    return EXIT_FAILURE_FILE;
+  }
 
-  file = fopen(fileName, "rb");
-  if (!file) {
-    ret = EXIT_FAILURE_FILE;
-    free(fileData->data);
-    goto exit;
+  RLE_State state = RLE_source_file(in, &source);
+  if (state == RLE_OK) {
+    state = RLE_sink_file(of, &sink);
+    if (state == RLE_OK) {
+      state = action->ioFnc(&source, &sink, &read, &written);
+      RLE_sink_close(&sink);
+    }
+    RLE_source_close(&source);
   }
+  fclose(in);
 
-  while ((readBytes = fread(pFileContent, 1, ALLOC_STEP, file)) == ALLOC_STEP) {
-    uint8_t* p = realloc(fileData->data, allocated + ALLOC_STEP);
+  if (fclose(of) != 0 || state != RLE_OK) {
+    fprintf(stderr, "Error while %s\n", action->errMsg);
+    remove(cfg->outputFileName);
+    return EXIT_RLE_ERROR;
+  }
 
-    if (p == NULL) {
-      fputs("Realloc error! The file may contain more bytes\n", stderr);
-      break;
-    }
+  fprintf(stdout, "%s done\nCompression ratio: %f %%\n", action->okMSg,
+          (double)read / written);
+  return EXIT_SUCCESS;
+}
 
-    fileData->data = p;
-    pFileContent = p + allocated;
-    allocated += ALLOC_STEP;
+/*! Processes the input file in chunks, so the memory used by RLE does not
+ * exceed the configured budget.
+ *
+ * \param[in] cfg   Pointer to structure with configuration.
+ *
+ * \return Returns non-zero value on error.
+ */
+static int runChunked(const struct Config* cfg) {
+  assert(cfg != NULL);
+  const struct Action* action = &cfg->rleAction;
+  RLE_FileOptions options = {cfg->maxMemory};
+  uint64_t read;
+  uint64_t written;
+
+  if (cfg->maxMemory < RLE_file_min_memory()) {
+    fprintf(stderr, "Memory budget is lower than %llu bytes\n",
+            (unsigned long long)RLE_file_min_memory());
+    return EXIT_FAILURE_MEMORY;
   }
 
-  allocated -= ALLOC_STEP - readBytes;
-  fileData->size = allocated;
-  fileData->data = realloc(fileData->data, allocated);
+  FILE* in = fopen(cfg->inputFileName, "rb");
+  if (in == NULL) {
+    return EXIT_FAILURE_FILE;
+  }
 
-  if (ferror(file)) {
-    free(fileData->data);
-    fileData->size = 0;
-    ret = EXIT_FAILURE_FILE;
+  FILE* of = fopen(cfg->outputFileName, "wb");
+  if (of == NULL) {
+    fclose(in);
+    return EXIT_FAILURE_FILE;
   }
 
-  fclose(file);
+  RLE_State state = action->chunkedFnc(in, of, &options, &read, &written);
+  fclose(in);
 
-exit:
-  return ret;
+  if (fclose(of) != 0 || state != RLE_OK) {
+    fprintf(stderr, "Error while %s\n", action->errMsg);
+    remove(cfg->outputFileName);
+    return EXIT_RLE_ERROR;
+  }
+
+  fprintf(stdout, "%s done\nCompression ratio: %f %%\n", action->okMSg,
+          (double)read / written);
+  return EXIT_SUCCESS;
+}
+
+#ifndef _WIN32
+/*! Decodes the input file to the output file with O_DIRECT writes, so the
+ * decoded data do not fill the page cache. The input is mapped to memory,
+ * which the memory source hands out in one read.
+ *
+ * \param[in] cfg   Pointer to structure with configuration.
+ *
+ * \return Returns non-zero value on error.
+ */
+static int runDirect(const struct Config* cfg) {
+  assert(cfg != NULL);
+  const struct Action* action = &cfg->rleAction;
+  RLE_Source source;
+  const uint8_t* in;
+  uint32_t len;
+  uint32_t rest;
+  uint64_t written = 0;
+  bool direct = false;
+
+  if (RLE_source_mmap(cfg->inputFileName, &source) != RLE_OK) {
+    return EXIT_FAILURE_FILE;
+  }
+
+  // The second read must hit the end, larger inputs are not supported.
+  RLE_State state = source.read(source.context, &in, &len, NULL, UINT32_MAX);
+  if (state == RLE_OK) {
+    const uint8_t* next;
+    state = source.read(source.context, &next, &rest, NULL, UINT32_MAX);
+  }
+  if (state == RLE_OK && rest == 0) {
+    state = RLE_decode_direct(in, len, cfg->outputFileName, &written, &direct);
+  } else {
+    state = RLE_ERROR;
+  }
+  RLE_source_close(&source);
+
+  if (state != RLE_OK) {
+    fprintf(stderr, "Error while %s\n", action->errMsg);
+    return EXIT_RLE_ERROR;
+  }
+
+  if (!direct) {
+    fputs("O_DIRECT not supported, the output was buffered\n", stderr);
+  }
+
+  fprintf(stdout, "%s done\nCompression ratio: %f %%\n", action->okMSg,
+          (double)len / written);
+  return EXIT_SUCCESS;
 }
+#endif
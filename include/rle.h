@@ -43,10 +43,21 @@ typedef struct {
 
 /*! Definition of RLE exit codes. */
 typedef enum {
-  RLE_OK,   /*!< RLE process finnished without error. */
-  RLE_ERROR /*!< Error detected while RLE. */
+  RLE_OK,         /*!< RLE process finnished without error. */
+  RLE_ERROR,      /*!< Error detected while RLE. */
+  RLE_ERROR_LIMIT /*!< Decoded data would exceed the allowed size. */
 } RLE_State;
 
+/*! Limits applied when decoding untrusted input. A single two byte run token
+ * expands to 127 bytes, so a small input can request a huge allocation. The
+ * limits are checked while the tokens are scanned, before any memory is
+ * allocated. Zero value disables the respective limit.
+ */
+typedef struct {
+  uint32_t maxOutputSize; /*!< Maximal size of decoded data in bytes. */
+  uint32_t maxRatio; /*!< Maximal ratio of decoded size to encoded size. */
+} RLE_DecodeOptions;
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
@@ -69,6 +80,51 @@ typedef enum {
  */
 RLE_State RLE_decode(const uint8_t *in, uint32_t len, RLE_Data *result);
 
+/*! Decodes RLE \a in byte array the same way as \ref RLE_decode, but refuses
+ * to produce more data than allowed by \a options. The size of decoded data is
+ * computed by scanning the tokens first, so the decoding fails before anything
+ * is allocated.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   options Decoding limits, NULL means no limits.
+ * \param[out]  result  Pointer to RLE_Data structure, where the decoded result
+ * will be stored.
+ *
+ * \return \ref RLE_ERROR_LIMIT if any limit is exceeded, \ref RLE_ERROR for
+ * malformed input or wrong arguments, \ref RLE_OK otherwise.
+ */
+RLE_State RLE_decode_ex(const uint8_t *in, uint32_t len,
+                        const RLE_DecodeOptions *options, RLE_Data *result);
+
+/*! Decodes RLE \a in byte array to the caller's \a out buffer instead of
+ * allocating the result. The input is validated before anything is written.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  out     Output buffer.
+ * \param[in]   size    Size of output buffer.
+ * \param[out]  written Size of decoded data.
+ *
+ * \return \ref RLE_ERROR_LIMIT if the decoded data do not fit to \a out,
+ * \ref RLE_ERROR for malformed input or wrong arguments, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_into(const uint8_t *in, uint32_t len, uint8_t *out,
+                          uint32_t size, uint32_t *written);
+
+/*! Computes the size of data decoded from RLE \a in byte array without
+ * decoding it. The input is validated the same way as in \ref RLE_decode.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  size    Size of decoded data, unchanged if error occurs.
+ *
+ * \return \ref RLE_ERROR for malformed input, \ref RLE_ERROR_LIMIT if the
+ * size does not fit into uint32_t, \ref RLE_OK otherwise.
+ */
+RLE_State RLE_decoded_size(const uint8_t *in, uint32_t len, uint32_t *size);
+
 /*! Encodes \a in byte array to RLE coded byte array. It
  * returns \ref RLE_Data structure with encoded data as pointer to heap. It
  * means that this function allocate certain space on heap where the data are
@@ -76,20 +132,28 @@ RLE_State RLE_decode(const uint8_t *in, uint32_t len, RLE_Data *result);
  *
  * The encode function simply reads the input buffer and counts how many
  * following bytes have the same value, and this value is recorded to the output
- * array with the encoded value after the number of bytes. This implies that the
- * result stream is a sequence of byte pairs where the first position is the
- * number of repetitions and the second number is the repeated value. The
- * encoding into two bytes means that the maximum number of repetitions is 255,
- * when the counter reaches this value, the byte is yielded and the counter is
- * reset.
+ * array with the encoded value after the number of bytes. Bytes which are not
+ * repeated are collected to a literal block, whose header has the MSB bit set
+ * and the length of the block stored in the bits 0:6. Because of the MSB flag,
+ * the maximum number of repetitions as well as the maximum literal block
+ * length is 127, when the counter reaches this value, the token is yielded and
+ * the counter is reset. A pair of equal bytes saves nothing as a run, so it is
+ * kept in the literal block unless it ends the data or precedes a run.
+ *
+ * Literal data longer than three literal blocks are written as a stored
+ * block, i.e. the header 0x80 followed by 16 bit little endian length and the
+ * bytes copied verbatim. The encoder emits stored blocks of at most 4096 bytes,
+ * so incompressible data grow by less than 0.1 % and any data by at most
+ * \ref RLE_encode_bound.
  *
  * For example:
  * input                                    | output
- * -----------------------------------------|---------------------
+ * -----------------------------------------|-------------------------
  * 65, 65, 65, 65                           | 4, 65
- * 65, 65, 66, 67                           | 2, 65, 1, 66, 1, 67
- * 65, 66, 67, 68                           | 1, 65, 1, 66, 1, 67, 1, 68
- * 65, 65, ...(65 repeated 263 times).., 65 | 255, 65, 10, 65
+ * 65, 65, 66, 67                           | 0x84, 65, 65, 66, 67
+ * 65, 66, 67, 67                           | 0x82, 65, 66, 2, 67
+ * 65, 65, ...(65 repeated 263 times).., 65 | 127, 65, 127, 65, 9, 65
+ * 1000 bytes without repetition            | 0x80, 0xe8, 0x03, 1000 bytes
  *
  * \param[in]   in      Input array
  * \param[in]   len     Length of input array
@@ -101,5 +165,30 @@ RLE_State RLE_decode(const uint8_t *in, uint32_t len, RLE_Data *result);
  */
 RLE_State RLE_encode(const uint8_t *in, uint32_t len, RLE_Data *result);
 
+/*! Encodes \a in byte array the same way as \ref RLE_encode, but to the
+ * caller's \a out buffer instead of allocating the result.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  out     Output buffer.
+ * \param[in]   size    Size of output buffer, at least
+ * \ref RLE_encode_bound of \a len.
+ * \param[out]  written Size of encoded data.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encode_into(const uint8_t *in, uint32_t len, uint8_t *out,
+                          uint64_t size, uint32_t *written);
+
+/*! Returns the maximal size of \a len bytes encoded by \ref RLE_encode, which
+ * is \a len + \a len / 127 + 1.
+ *
+ * \param[in]   len     Length of input array.
+ *
+ * \return Maximal size of encoded data.
+ */
+uint64_t RLE_encode_bound(uint32_t len);
+
 /*! \} */
 #endif  // RLE_H
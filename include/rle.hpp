@@ -0,0 +1,836 @@
+/*!
+ * \file    rle.hpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   C++ interface of RLE module.
+ *
+ * \defgroup RLE_CPP  RLE C++ interface
+ * \ingroup RLE
+ *
+ * Header only C++ layer over the RLE module. The \ref rle::view class exposes
+ * encoded data as a forward range of decoded bytes and as an input range of
+ * runs. The data are decoded on the fly while iterating, so scanning the data
+ * once needs no allocation and O(1) extra memory.
+ *
+ * The \ref rle::encode and \ref rle::decode functions take any contiguous
+ * range of bytes as \ref rle::bytes, e.g. \c std::vector, \c std::string or
+ * \c std::span<const std::byte>. They either return the result as a move-only
+ * \ref rle::buffer owning the memory allocated by the C functions, or append
+ * it to a container of the caller, whose capacity is reused. The result is
+ * written in place in both cases, it is never copied. Errors are reported by
+ * the \ref rle::error exception.
+ *
+ * With C++17 and \c <memory_resource> available, \ref RLE_HAS_PMR is defined
+ * and the functions also take a \c std::pmr::memory_resource and return
+ * \c std::pmr::vector allocated from it. The codec needs no other memory in
+ * that case, so nothing is allocated from the global heap.
+ *
+ * With C++20 coroutines available, \ref RLE_HAS_COROUTINES is defined and
+ * \ref rle::encode_stream and \ref rle::decode_stream produce the output as a
+ * \ref rle::chunk_stream. It is a generator yielding chunks of fixed size, the
+ * last one may be shorter. The coroutine pulls the next input piece only when
+ * the consumer asks for more output, so it interleaves with other work on the
+ * same thread. Its frame holds the state of the resumable coder of
+ * \ref RLE_STREAM, suspension saves nothing else.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_HPP
+#define RLE_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 201703L
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#include <vector>
+
+/*! Defined if the functions taking \c std::pmr::memory_resource exist. */
+#define RLE_HAS_PMR 1
+#endif
+#endif
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+#if __has_include(<coroutine>) && __has_include(<ranges>)
+#include <algorithm>
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <ranges>
+#include <vector>
+
+/*! Defined if \ref rle::encode_stream and \ref rle::decode_stream exist. */
+#define RLE_HAS_COROUTINES 1
+#endif
+#endif
+
+extern "C" {
+#include "rle.h"
+#ifdef RLE_HAS_COROUTINES
+#include "rle_io.h"
+#include "rle_stream.h"
+#endif
+}
+
+namespace rle {
+
+/* Exported types ------------------------------------------------------------*/
+/*! One run of decoded data, i.e. \a length repetitions of \a value. */
+struct run {
+  std::uint8_t value; /*!< Repeated value. */
+  std::size_t length; /*!< Number of repetitions. */
+};
+
+/*! Exception reporting a failure of the C functions. */
+class error : public std::runtime_error {
+ public:
+  explicit error(RLE_State state)
+      : std::runtime_error(state == RLE_ERROR_LIMIT ? "RLE limit exceeded"
+                                                    : "RLE error"),
+        state_(state) {}
+
+  /*! Returns the state returned by the failed function. */
+  RLE_State state() const noexcept {
+    return state_;
+  }
+
+ private:
+  RLE_State state_; /*!< State returned by the failed function. */
+};
+
+namespace detail {
+
+/*! Returns the data of a contiguous container of byte sized elements. */
+template <class Container>
+auto byte_data(const Container &container) noexcept -> typename std::enable_if<
+    sizeof(*container.data()) == 1, const std::uint8_t *>::type {
+  return reinterpret_cast<const std::uint8_t *>(container.data());
+}
+
+/*! Returns writable data of a contiguous container of byte sized elements. */
+template <class Container>
+std::uint8_t *byte_data(Container &container, std::size_t pos) noexcept {
+  return reinterpret_cast<std::uint8_t *>(&container[0]) + pos;
+}
+
+/*! Returns the size of \a data as accepted by the C functions. */
+inline std::uint32_t length(std::size_t size) {
+  if (size > std::numeric_limits<std::uint32_t>::max()) {
+    throw error(RLE_ERROR);
+  }
+  return static_cast<std::uint32_t>(size);
+}
+
+/*! Cursor reading the encoded data unit by unit. A unit is either a whole run
+ * token or a single byte of a literal block. Malformed token ends the data.
+ */
+class cursor {
+ public:
+  cursor() noexcept = default;
+  cursor(const std::uint8_t *data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  /*! Moves the cursor behind the end of data. */
+  void finish() noexcept {
+    pos_ = size_;
+    literal_ = 0;
+  }
+
+  /*! Reads next unit, returns false at the end of data. */
+  bool next(const std::uint8_t *&value, std::size_t &length) noexcept {
+    if (literal_ == 0) {
+      if (pos_ >= size_) {
+        return false;
+      }
+
+      std::uint8_t header = data_[pos_];
+      std::size_t start = pos_ + 1;
+      std::size_t count = header & 0x7f;
+      if (header == 0x80 && size_ - start >= 2) {
+        // Stored block with 16 bit little endian length.
+        count = data_[start] | static_cast<std::size_t>(data_[start + 1]) << 8;
+        start += 2;
+      }
+      std::size_t payload = (header & 0x80) ? count : 1;
+      if (count == 0 || size_ - start < payload) {
+        finish();
+        return false;
+      }
+
+      pos_ = start;
+      if ((header & 0x80) == 0) {
+        value = &data_[pos_++];
+        length = count;
+        return true;
+      }
+      literal_ = count;
+    }
+
+    value = &data_[pos_++];
+    length = 1;
+    literal_--;
+    return true;
+  }
+
+  bool operator==(const cursor &other) const noexcept {
+    return pos_ == other.pos_ && literal_ == other.literal_;
+  }
+
+ private:
+  const std::uint8_t *data_ = nullptr; /*!< Encoded data. */
+  std::size_t size_ = 0;               /*!< Size of encoded data. */
+  std::size_t pos_ = 0;                /*!< Position of next unread byte. */
+  std::size_t literal_ = 0; /*!< Unread bytes of current literal block. */
+};
+
+}  // namespace detail
+
+/*! Non-owning contiguous range of bytes, i.e. the span accepted by the
+ * functions. It is implicitly created from any container with \c data() and
+ * \c size() of byte sized elements, so \c std::span<const std::byte> works
+ * the same as \c std::vector<std::uint8_t> or \c std::string.
+ */
+class bytes {
+ public:
+  bytes() noexcept = default;
+  bytes(const void *data, std::size_t size) noexcept
+      : data_(static_cast<const std::uint8_t *>(data)), size_(size) {}
+  template <class Container,
+            class = decltype(detail::byte_data(std::declval<Container>()))>
+  bytes(const Container &container) noexcept
+      : data_(detail::byte_data(container)), size_(container.size()) {}
+
+  /*! Returns pointer to the first byte. */
+  const std::uint8_t *data() const noexcept {
+    return data_;
+  }
+
+  /*! Returns the number of bytes. */
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+ private:
+  const std::uint8_t *data_ = nullptr; /*!< First byte. */
+  std::size_t size_ = 0;               /*!< Number of bytes. */
+};
+
+/*! Move-only owner of the data allocated by the C functions. */
+class buffer {
+ public:
+  buffer() noexcept = default;
+
+  /*! Takes the ownership of \a data allocated on heap. */
+  explicit buffer(RLE_Data data) noexcept
+      : data_(data.data), size_(data.size) {}
+  buffer(buffer &&other) noexcept
+      : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  buffer &operator=(buffer &&other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+  buffer(const buffer &) = delete;
+  buffer &operator=(const buffer &) = delete;
+  ~buffer() {
+    std::free(data_);
+  }
+
+  /*! Returns pointer to the first byte, NULL if empty. */
+  std::uint8_t *data() noexcept {
+    return data_;
+  }
+  const std::uint8_t *data() const noexcept {
+    return data_;
+  }
+
+  /*! Returns the number of bytes. */
+  std::size_t size() const noexcept {
+    return size_;
+  }
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  std::uint8_t &operator[](std::size_t i) noexcept {
+    return data_[i];
+  }
+  const std::uint8_t &operator[](std::size_t i) const noexcept {
+    return data_[i];
+  }
+
+  const std::uint8_t *begin() const noexcept {
+    return data_;
+  }
+  const std::uint8_t *end() const noexcept {
+    return data_ + size_;
+  }
+
+  /*! Passes the ownership of the data to the caller, who frees them. */
+  RLE_Data release() noexcept {
+    RLE_Data data = {data_, static_cast<std::uint32_t>(size_)};
+    data_ = nullptr;
+    size_ = 0;
+    return data;
+  }
+
+ private:
+  std::uint8_t *data_ = nullptr; /*!< Owned data allocated on heap. */
+  std::size_t size_ = 0;         /*!< Number of bytes. */
+};
+
+/*! Forward range over encoded data. The view does not own the data, which must
+ * outlive it and all its iterators. Iteration stops at the first malformed
+ * token, use \ref RLE_decoded_size to validate untrusted input beforehand.
+ */
+class view {
+ public:
+  /*! Forward iterator over decoded bytes. */
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::uint8_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::uint8_t *;
+    using reference = const std::uint8_t &;
+
+    iterator() noexcept = default;
+
+    reference operator*() const noexcept {
+      return *value_;
+    }
+    pointer operator->() const noexcept {
+      return value_;
+    }
+
+    iterator &operator++() noexcept {
+      if (--remaining_ == 0) {
+        load();
+      }
+      return *this;
+    }
+    iterator operator++(int) noexcept {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const noexcept {
+      return cursor_ == other.cursor_ && remaining_ == other.remaining_;
+    }
+    bool operator!=(const iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    friend class view;
+
+    explicit iterator(detail::cursor cursor) noexcept : cursor_(cursor) {
+      load();
+    }
+
+    void load() noexcept {
+      if (!cursor_.next(value_, remaining_)) {
+        remaining_ = 0;
+      }
+    }
+
+    detail::cursor cursor_;               /*!< Position in encoded data. */
+    const std::uint8_t *value_ = nullptr; /*!< Current decoded byte. */
+    std::size_t remaining_ = 0; /*!< Remaining repetitions of current byte. */
+  };
+
+  /*! Input iterator over runs. Adjacent tokens with the same value are
+   * merged, so the runs do not depend on how the data were tokenized. The run
+   * is built in the iterator while it is advanced, so it is returned by value.
+   */
+  class run_iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = run;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = run;
+
+    run_iterator() noexcept = default;
+
+    reference operator*() const noexcept {
+      return run_;
+    }
+
+    run_iterator &operator++() noexcept {
+      load();
+      return *this;
+    }
+    run_iterator operator++(int) noexcept {
+      run_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const run_iterator &other) const noexcept {
+      return cursor_ == other.cursor_ && run_.length == other.run_.length;
+    }
+    bool operator!=(const run_iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    friend class view;
+
+    explicit run_iterator(detail::cursor cursor) noexcept : cursor_(cursor) {
+      load();
+    }
+
+    void load() noexcept {
+      const std::uint8_t *value;
+      std::size_t length;
+
+      run_.length = 0;
+      if (!cursor_.next(value, length)) {
+        return;
+      }
+
+      run_.value = *value;
+      run_.length = length;
+
+      detail::cursor ahead = cursor_;
+      while (ahead.next(value, length) && *value == run_.value) {
+        run_.length += length;
+        cursor_ = ahead;
+      }
+    }
+
+    detail::cursor cursor_; /*!< Position behind the current run. */
+    run run_ = {0, 0};      /*!< Current run, zero length at the end. */
+  };
+
+  /*! Range of runs returned by \ref view::runs. */
+  class run_range {
+   public:
+    run_iterator begin() const noexcept {
+      return begin_;
+    }
+    run_iterator end() const noexcept {
+      return end_;
+    }
+
+   private:
+    friend class view;
+
+    run_range(run_iterator begin, run_iterator end) noexcept
+        : begin_(begin), end_(end) {}
+
+    run_iterator begin_; /*!< First run. */
+    run_iterator end_;   /*!< Iterator behind the last run. */
+  };
+
+  view() noexcept = default;
+  view(const std::uint8_t *data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+  explicit view(const RLE_Data &data) noexcept
+      : data_(data.data), size_(data.size) {}
+  explicit view(bytes data) noexcept : data_(data.data()), size_(data.size()) {}
+
+  /*! Returns iterator to the first decoded byte. */
+  iterator begin() const noexcept {
+    return iterator(detail::cursor(data_, size_));
+  }
+
+  /*! Returns iterator behind the last decoded byte. */
+  iterator end() const noexcept {
+    return iterator(end_cursor());
+  }
+
+  /*! Returns the range of runs in the decoded data. */
+  run_range runs() const noexcept {
+    return run_range(run_iterator(detail::cursor(data_, size_)),
+                     run_iterator(end_cursor()));
+  }
+
+ private:
+  detail::cursor end_cursor() const noexcept {
+    detail::cursor c(data_, size_);
+    c.finish();
+    return c;
+  }
+
+  const std::uint8_t *data_ = nullptr; /*!< Encoded data. */
+  std::size_t size_ = 0;               /*!< Size of encoded data. */
+};
+
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Encodes \a in by \ref RLE_encode.
+ *
+ * \param[in]   in      Input data, not empty.
+ *
+ * \return Encoded data.
+ * \throw error If the input is empty or too large or allocation failed.
+ */
+inline buffer encode(bytes in) {
+  RLE_Data result = {nullptr, 0};
+  RLE_State state = RLE_encode(in.data(), detail::length(in.size()), &result);
+  if (state != RLE_OK) {
+    throw error(state);
+  }
+  return buffer(result);
+}
+
+/*! Encodes \a in by \ref RLE_encode_into and appends the result to \a out.
+ * Clear the container beforehand to reuse its capacity for a new result.
+ *
+ * \param[in]     in     Input data, not empty.
+ * \param[in,out] out    Container of byte sized elements with \c resize(),
+ * e.g. \c std::vector<std::uint8_t>. It is unchanged if an error occurs.
+ *
+ * \throw error If the input is empty or too large.
+ */
+template <class Container>
+auto encode(bytes in, Container &out)
+    -> decltype(detail::byte_data(out), out.resize(0), void()) {
+  std::uint32_t len = detail::length(in.size());
+  std::size_t pos = out.size();
+
+  out.resize(pos + RLE_encode_bound(len));
+  std::uint32_t written = 0;
+  RLE_State state = RLE_encode_into(in.data(), len, detail::byte_data(out, pos),
+                                    RLE_encode_bound(len), &written);
+  out.resize(pos + written);
+  if (state != RLE_OK) {
+    throw error(state);
+  }
+}
+
+/*! Decodes \a in by \ref RLE_decode.
+ *
+ * \param[in]   in      Encoded data, not empty.
+ *
+ * \return Decoded data.
+ * \throw error If the input is malformed or allocation failed.
+ */
+inline buffer decode(bytes in) {
+  RLE_Data result = {nullptr, 0};
+  RLE_State state = RLE_decode(in.data(), detail::length(in.size()), &result);
+  if (state != RLE_OK) {
+    throw error(state);
+  }
+  return buffer(result);
+}
+
+/*! Decodes \a in by \ref RLE_decode_ex within the \a options limits.
+ *
+ * \param[in]   in      Encoded data, not empty.
+ * \param[in]   options Decoding limits.
+ *
+ * \return Decoded data.
+ * \throw error With \ref RLE_ERROR_LIMIT if any limit is exceeded, with
+ * \ref RLE_ERROR if the input is malformed or allocation failed.
+ */
+inline buffer decode(bytes in, const RLE_DecodeOptions &options) {
+  RLE_Data result = {nullptr, 0};
+  RLE_State state =
+      RLE_decode_ex(in.data(), detail::length(in.size()), &options, &result);
+  if (state != RLE_OK) {
+    throw error(state);
+  }
+  return buffer(result);
+}
+
+/*! Decodes \a in by \ref RLE_decode_into and appends the result to \a out.
+ * Clear the container beforehand to reuse its capacity for a new result.
+ *
+ * \param[in]     in     Encoded data, not empty.
+ * \param[in,out] out    Container of byte sized elements with \c resize(),
+ * e.g. \c std::vector<std::uint8_t>. It is unchanged if an error occurs.
+ *
+ * \throw error If the input is malformed.
+ */
+template <class Container>
+auto decode(bytes in, Container &out)
+    -> decltype(detail::byte_data(out), out.resize(0), void()) {
+  std::uint32_t len = detail::length(in.size());
+  std::uint32_t size = 0;
+  RLE_State state = RLE_decoded_size(in.data(), len, &size);
+  if (state != RLE_OK) {
+    throw error(state);
+  }
+
+  std::size_t pos = out.size();
+  out.resize(pos + size);
+  if (size > 0) {
+    std::uint32_t written = 0;
+    RLE_decode_into(in.data(), len, detail::byte_data(out, pos), size,
+                    &written);
+  }
+}
+
+#ifdef RLE_HAS_PMR
+/*! Encodes \a in to a vector allocated from \a resource. The vector keeps
+ * the capacity of \ref RLE_encode_bound bytes, because shrinking it would
+ * allocate again.
+ *
+ * \param[in]   in       Input data, not empty.
+ * \param[in]   resource Memory resource of the result.
+ *
+ * \return Encoded data.
+ * \throw error If the input is empty or too large.
+ */
+inline std::pmr::vector<std::uint8_t> encode(
+    bytes in, std::pmr::memory_resource *resource) {
+  std::pmr::vector<std::uint8_t> out(resource);
+  encode(in, out);
+  return out;
+}
+
+/*! Decodes \a in to a vector allocated from \a resource.
+ *
+ * \param[in]   in       Encoded data, not empty.
+ * \param[in]   resource Memory resource of the result.
+ *
+ * \return Decoded data.
+ * \throw error If the input is malformed.
+ */
+inline std::pmr::vector<std::uint8_t> decode(
+    bytes in, std::pmr::memory_resource *resource) {
+  std::pmr::vector<std::uint8_t> out(resource);
+  decode(in, out);
+  return out;
+}
+#endif
+
+#ifdef RLE_HAS_COROUTINES
+/*! Generator of output chunks. It is an input range of \ref bytes, each chunk
+ * stays valid until the iterator is incremented. An error of the coder is
+ * thrown from the increment, which resumes it.
+ */
+class chunk_stream {
+ public:
+  /*! Promise of the coroutine. */
+  struct promise_type {
+    bytes chunk;               /*!< Last yielded chunk. */
+    std::exception_ptr error;  /*!< Exception thrown by the coroutine. */
+
+    chunk_stream get_return_object() noexcept {
+      return chunk_stream(handle::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+    std::suspend_always final_suspend() noexcept {
+      return {};
+    }
+    std::suspend_always yield_value(bytes next) noexcept {
+      chunk = next;
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+      error = std::current_exception();
+    }
+  };
+
+  /*! Input iterator over the chunks. */
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = bytes;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+
+    const bytes &operator*() const noexcept {
+      return handle_.promise().chunk;
+    }
+    iterator &operator++() {
+      resume(handle_);
+      return *this;
+    }
+    void operator++(int) {
+      ++*this;
+    }
+
+    bool operator==(std::default_sentinel_t) const noexcept {
+      return handle_ == nullptr || handle_.done();
+    }
+
+   private:
+    friend class chunk_stream;
+
+    explicit iterator(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_; /*!< Running coroutine. */
+  };
+
+  chunk_stream(chunk_stream &&other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  chunk_stream &operator=(chunk_stream &&other) noexcept {
+    std::swap(handle_, other.handle_);
+    return *this;
+  }
+  chunk_stream(const chunk_stream &) = delete;
+  chunk_stream &operator=(const chunk_stream &) = delete;
+  ~chunk_stream() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  /*! Runs the coroutine to the first chunk, may be called once only. */
+  iterator begin() {
+    resume(handle_);
+    return iterator(handle_);
+  }
+  std::default_sentinel_t end() const noexcept {
+    return {};
+  }
+
+ private:
+  using handle = std::coroutine_handle<promise_type>;
+
+  explicit chunk_stream(handle coroutine) noexcept : handle_(coroutine) {}
+
+  /*! Resumes the coroutine and rethrows its exception. */
+  static void resume(handle coroutine) {
+    coroutine.resume();
+    if (coroutine.done() && coroutine.promise().error) {
+      std::rethrow_exception(std::exchange(coroutine.promise().error, {}));
+    }
+  }
+
+  handle handle_; /*!< Owned coroutine. */
+};
+
+/*! Input range of pieces convertible to \ref bytes, e.g. a vector of buffers
+ * or another \ref chunk_stream. */
+template <class Input>
+concept byte_pieces = std::ranges::input_range<Input> &&
+    std::convertible_to<std::ranges::range_reference_t<Input>, bytes>;
+
+/*! Encodes the pieces of \a input as one data. The output equals
+ * \ref RLE_encode of the concatenated pieces, empty input yields nothing.
+ *
+ * \param[in]   input    Input pieces, moved to the coroutine. Pass a view to
+ * avoid copying a container.
+ * \param[in]   chunk    Size of yielded chunks, not zero.
+ *
+ * \return Generator of encoded chunks.
+ */
+template <byte_pieces Input>
+chunk_stream encode_stream(Input input,
+                           std::uint32_t chunk = RLE_IO_CHUNK_SIZE) {
+  if (chunk == 0) {
+    throw error(RLE_ERROR);
+  }
+
+  // The input is fed by at most chunk bytes, whose tokens may overflow the
+  // chunk. The overflow is moved to the start once the chunk is consumed.
+  RLE_Encoder encoder;
+  std::vector<std::uint8_t> out(chunk + RLE_encoder_bound(chunk));
+  std::size_t filled = 0;
+  std::uint32_t outLen = 0;
+
+  RLE_encoder_init(&encoder);
+  for (bytes piece : input) {
+    const std::uint8_t *data = piece.data();
+    std::size_t left = piece.size();
+    while (left > 0) {
+      std::uint32_t n = static_cast<std::uint32_t>(
+          std::min<std::size_t>(left, chunk));
+      if (RLE_encoder_feed(&encoder, data, n, &out[filled], &outLen) !=
+          RLE_OK) {
+        throw error(RLE_ERROR);
+      }
+      data += n;
+      left -= n;
+      filled += outLen;
+      for (; filled >= chunk; filled -= chunk) {
+        co_yield bytes(out.data(), chunk);
+        std::memmove(out.data(), &out[chunk], filled - chunk);
+      }
+    }
+  }
+
+  if (RLE_encoder_finish(&encoder, &out[filled], &outLen) != RLE_OK) {
+    throw error(RLE_ERROR);
+  }
+  filled += outLen;
+  for (; filled >= chunk; filled -= chunk) {
+    co_yield bytes(out.data(), chunk);
+    std::memmove(out.data(), &out[chunk], filled - chunk);
+  }
+  if (filled > 0) {
+    co_yield bytes(out.data(), filled);
+  }
+}
+
+/*! Decodes the pieces of \a input as one encoded data. The chunks are yielded
+ * as soon as they are decoded, so part of the output may be yielded before
+ * malformed or truncated input is detected.
+ *
+ * \param[in]   input    Encoded pieces, moved to the coroutine. Pass a view
+ * to avoid copying a container.
+ * \param[in]   chunk    Size of yielded chunks, not zero.
+ *
+ * \return Generator of decoded chunks.
+ */
+template <byte_pieces Input>
+chunk_stream decode_stream(Input input,
+                           std::uint32_t chunk = RLE_IO_CHUNK_SIZE) {
+  if (chunk == 0) {
+    throw error(RLE_ERROR);
+  }
+
+  RLE_Decoder decoder;
+  std::vector<std::uint8_t> out(chunk);
+  std::uint32_t filled = 0;
+
+  RLE_decoder_init(&decoder);
+  for (bytes piece : input) {
+    const std::uint8_t *data = piece.data();
+    std::uint32_t len = detail::length(piece.size());
+    bool full;
+    do {
+      std::uint32_t outLen = 0;
+      if (RLE_decoder_feed(&decoder, &data, &len, &out[filled], chunk - filled,
+                           &outLen) != RLE_OK) {
+        throw error(RLE_ERROR);
+      }
+      full = outLen == chunk - filled;
+      filled += outLen;
+      if (filled == chunk) {
+        co_yield bytes(out.data(), chunk);
+        filled = 0;
+      }
+    } while (len > 0 || full);
+  }
+
+  if (RLE_decoder_finish(&decoder) != RLE_OK) {
+    throw error(RLE_ERROR);
+  }
+  if (filled > 0) {
+    co_yield bytes(out.data(), filled);
+  }
+}
+#endif
+
+}  // namespace rle
+
+/*! \} */
+#endif  // RLE_HPP
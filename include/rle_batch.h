@@ -0,0 +1,84 @@
+/*!
+ * \file    rle_batch.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of batch RLE coding of many small buffers.
+ *
+ * \defgroup RLE_BATCH  RLE batch coding
+ * \ingroup RLE
+ *
+ * Coding of buffers of a few hundred bytes is dominated by the per-call
+ * overhead, i.e. argument checks, one allocation per result and the branches
+ * of a single token stream, which stall the core. The batch functions code
+ * many buffers by one call into one contiguous arena allocated on heap and
+ * describe the position of each result by an offsets table provided by the
+ * caller. The result of the k-th buffer occupies bytes from offsets[k] to
+ * offsets[k + 1] of the arena.
+ *
+ * Several buffers are coded at once, one token of each buffer in turn, so the
+ * independent token streams overlap in the pipeline of the core.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_BATCH_H
+#define RLE_BATCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Input buffer of the batch. */
+typedef struct {
+  const uint8_t *data; /*!< Buffer data, may be NULL if size is zero. */
+  uint32_t size;       /*!< Size of buffer, may be zero. */
+} RLE_Span;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Encodes each of \a count \a inputs by \ref RLE_encode into one arena. Empty
+ * input produces empty result. The arena is allocated on heap, it is NULL
+ * if all results are empty.
+ *
+ * \param[in]   inputs    Array of input buffers.
+ * \param[in]   count     Number of input buffers.
+ * \param[out]  result    Pointer to RLE_Data structure, where the arena of
+ * encoded data will be stored.
+ * \param[out]  offsets   Array of \a count + 1 offsets of encoded data in the
+ * arena.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encode_batch(const RLE_Span *inputs, uint32_t count,
+                           RLE_Data *result, uint32_t *offsets);
+
+/*! Decodes each of \a count \a inputs by \ref RLE_decode into one arena. All
+ * inputs are validated before the arena is allocated, so nothing is decoded
+ * if any input is malformed. The arena is NULL if all results are empty.
+ *
+ * \param[in]   inputs    Array of encoded buffers.
+ * \param[in]   count     Number of encoded buffers.
+ * \param[out]  result    Pointer to RLE_Data structure, where the arena of
+ * decoded data will be stored.
+ * \param[out]  offsets   Array of \a count + 1 offsets of decoded data in the
+ * arena.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_batch(const RLE_Span *inputs, uint32_t count,
+                           RLE_Data *result, uint32_t *offsets);
+
+/*! \} */
+#endif  // RLE_BATCH_H
@@ -0,0 +1,105 @@
+/*!
+ * \file    rle_context.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of RLE coding with a reusable context.
+ *
+ * \defgroup RLE_CONTEXT  RLE context
+ * \ingroup RLE
+ *
+ * \ref RLE_encode and \ref RLE_decode allocate a new result by every call.
+ * The context owns one output buffer instead, which only grows and is reused
+ * by the following calls, and keeps the decoding limits. Once the buffer
+ * holds the largest result, the calls allocate nothing. The result of a call
+ * is valid until the next call with the same context.
+ *
+ * The coder keeps no global state, its scans are selected at compile time,
+ * so there is nothing else to cache. The context is not locked, keep one per
+ * thread.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_CONTEXT_H
+#define RLE_CONTEXT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+#include "rle_batch.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Reusable state of the coder. */
+typedef struct {
+  uint8_t *buffer;           /*!< Output buffer on heap, NULL if empty. */
+  uint32_t capacity;         /*!< Size of the output buffer. */
+  RLE_DecodeOptions options; /*!< Limits of \ref RLE_context_decode. */
+} RLE_Context;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Initializes the \a context with an empty buffer.
+ *
+ * \param[out]  context   Initialized context.
+ * \param[in]   options   Decoding limits, NULL means no limits.
+ */
+void RLE_context_init(RLE_Context *context, const RLE_DecodeOptions *options);
+
+/*! Grows the buffer of the \a context to at least \a capacity bytes, so the
+ * following calls with smaller results allocate nothing.
+ *
+ * \param[in,out] context   Context.
+ * \param[in]     capacity  Required size of the buffer.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_context_reserve(RLE_Context *context, uint32_t capacity);
+
+/*! Encodes \a in by \ref RLE_encode to the buffer of the \a context.
+ *
+ * \param[in,out] context   Context.
+ * \param[in]     in        Input array.
+ * \param[in]     len       Length of input array.
+ * \param[out]    result    Encoded data in the buffer of the context.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_context_encode(RLE_Context *context, const uint8_t *in,
+                             uint32_t len, RLE_Span *result);
+
+/*! Decodes \a in by \ref RLE_decode_ex with the limits of the \a context to
+ * its buffer. A result, which fits to the buffer, is validated and decoded by
+ * one pass. A larger result costs the partial pass, a scan of the decoded size
+ * and the decoding to the grown buffer. The buffer content is undefined after
+ * an error.
+ *
+ * \param[in,out] context   Context.
+ * \param[in]     in        Encoded input array.
+ * \param[in]     len       Length of input array.
+ * \param[out]    result    Decoded data in the buffer of the context.
+ *
+ * \return \ref RLE_ERROR_LIMIT if any limit is exceeded, \ref RLE_ERROR for
+ * malformed input or wrong arguments, \ref RLE_OK otherwise.
+ */
+RLE_State RLE_context_decode(RLE_Context *context, const uint8_t *in,
+                             uint32_t len, RLE_Span *result);
+
+/*! Releases the buffer of the \a context, which is then empty.
+ *
+ * \param[in,out] context   Context.
+ */
+void RLE_context_free(RLE_Context *context);
+
+/*! \} */
+#endif  // RLE_CONTEXT_H
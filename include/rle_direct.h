@@ -0,0 +1,68 @@
+/*!
+ * \file    rle_direct.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of RLE decoding to files bypassing the page cache.
+ *
+ * \defgroup RLE_DIRECT  RLE direct output
+ * \ingroup RLE
+ *
+ * Large decoded files written through the page cache evict pages of other
+ * processes, although the data are rarely read back soon. The function in
+ * this module opens the output with \c O_DIRECT and writes aligned blocks
+ * from two buffers. The decoder fills one buffer while a writer thread writes
+ * the other one, so decoding and the device work in parallel.
+ *
+ * If the file system rejects \c O_DIRECT, either when the file is opened or
+ * on the first write, the output falls back to ordinary buffered writes. The
+ * unaligned tail of the data is written after \c O_DIRECT is cleared.
+ *
+ * The module is available on POSIX systems only.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_DIRECT_H
+#define RLE_DIRECT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/*! Alignment of the buffers and of the direct writes. */
+#define RLE_DIRECT_ALIGNMENT (4096)
+
+/*! Size of each of the two output buffers. */
+#define RLE_DIRECT_BUFFER_SIZE (1u << 20)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Decodes RLE \a in byte array to the file at \a path, which is created or
+ * truncated. The input is validated before the file is opened, so malformed
+ * input produces no output.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   path    Path to the output file.
+ * \param[out]  written Number of written bytes, may be NULL.
+ * \param[out]  direct  True if the data bypassed the page cache, may be NULL.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_direct(const uint8_t *in, uint32_t len, const char *path,
+                            uint64_t *written, bool *direct);
+
+/*! \} */
+#endif  // RLE_DIRECT_H
@@ -0,0 +1,142 @@
+/*!
+ * \file    rle_edit.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of editing operations on RLE encoded data.
+ *
+ * \defgroup RLE_EDIT  RLE editing of encoded data
+ * \ingroup RLE
+ *
+ * The functions in this module modify encoded data without decoding and
+ * encoding them as a whole. Only the tokens next to the modified place are
+ * decoded and encoded again, the rest of data is copied as is. Locating the
+ * tokens only walks the token headers.
+ *
+ * The last token of encoded data can only be found by walking all their
+ * tokens. \ref RLE_concat_ex and \ref RLE_append_ex take its position known
+ * by the caller and return it for the joined data, so a join costs the seam
+ * and the walk of the appended data. Repeated appends then stay linear in
+ * the total size.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_EDIT_H
+#define RLE_EDIT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/*! Position of the last token, which is not known and has to be found. */
+#define RLE_EDIT_LAST_UNKNOWN (UINT32_MAX)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Concatenates two encoded streams. The last token of \a first and the first
+ * token of \a second are encoded again, so a run spanning the seam is merged
+ * and literal blocks are coalesced up to the 127 bytes limit. The result is
+ * allocated on heap the same way as in \ref RLE_encode.
+ *
+ * \param[in]   first       First encoded array.
+ * \param[in]   firstLen    Length of the first array, may be zero.
+ * \param[in]   second      Second encoded array.
+ * \param[in]   secondLen   Length of the second array.
+ * \param[out]  result      Pointer to RLE_Data structure, where the
+ * concatenated data will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_concat(const uint8_t *first, uint32_t firstLen,
+                     const uint8_t *second, uint32_t secondLen,
+                     RLE_Data *result);
+
+/*! Concatenates two encoded streams as \ref RLE_concat. The position of the
+ * last token of \a first is passed by \a last, only that token is validated.
+ *
+ * \param[in]     first       First encoded array.
+ * \param[in]     firstLen    Length of the first array, may be zero.
+ * \param[in]     second      Second encoded array.
+ * \param[in]     secondLen   Length of the second array.
+ * \param[out]    result      Pointer to RLE_Data structure, where the
+ * concatenated data will be stored.
+ * \param[in,out] last        Position of the last token of \a first, zero for
+ * empty \a first or \ref RLE_EDIT_LAST_UNKNOWN. Position of the last token of
+ * \a result on success.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_concat_ex(const uint8_t *first, uint32_t firstLen,
+                        const uint8_t *second, uint32_t secondLen,
+                        RLE_Data *result, uint32_t *last);
+
+/*! Appends encoded \a in array to the encoded data in \a data. The heap buffer
+ * of \a data is reallocated, the seam is handled as in \ref RLE_concat. An
+ * empty \a data structure (NULL pointer and zero size) is accepted. If error
+ * is detected, \a data is not modified.
+ *
+ * \param[in,out] data    Encoded data allocated on heap.
+ * \param[in]     in      Encoded array to append.
+ * \param[in]     len     Length of the appended array.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_append(RLE_Data *data, const uint8_t *in, uint32_t len);
+
+/*! Appends encoded \a in array to the encoded data in \a data as
+ * \ref RLE_append. The position of the last token of \a data is passed by
+ * \a last, only that token is validated.
+ *
+ * \param[in,out] data    Encoded data allocated on heap.
+ * \param[in]     in      Encoded array to append.
+ * \param[in]     len     Length of the appended array.
+ * \param[in,out] last    Position of the last token of \a data, zero for
+ * empty \a data or \ref RLE_EDIT_LAST_UNKNOWN. Updated on success.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_append_ex(RLE_Data *data, const uint8_t *in, uint32_t len,
+                        uint32_t *last);
+
+/*! Replaces \a length bytes of decoded data starting at \a offset with
+ * \a replacement bytes. The replacement may be longer or shorter than the
+ * replaced range, zero \a length inserts the bytes and zero \a replacementLen
+ * removes the range. Only the tokens touching the range and its neighbouring
+ * bytes are encoded again and spliced into the heap buffer of \a data, runs
+ * are split or merged as needed. If error is detected, \a data is not
+ * modified.
+ *
+ * The token headers are walked from the start up to the patched range only,
+ * the tokens behind it are neither walked nor validated. Moving the encoded
+ * tail behind the spliced tokens is the only cost, which grows with the size
+ * of data behind the range.
+ *
+ * \param[in,out] data            Encoded data allocated on heap.
+ * \param[in]     offset          Start of the replaced range in decoded data.
+ * \param[in]     length          Length of the replaced range.
+ * \param[in]     replacement     New bytes, may be NULL if replacementLen is
+ * zero.
+ * \param[in]     replacementLen  Number of new bytes.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_patch(RLE_Data *data, uint32_t offset, uint32_t length,
+                    const uint8_t *replacement, uint32_t replacementLen);
+
+/*! \} */
+#endif  // RLE_EDIT_H
@@ -0,0 +1,87 @@
+/*!
+ * \file    rle_entropy.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of entropy coded RLE.
+ *
+ * \defgroup RLE_ENTROPY  RLE entropy coding
+ * \ingroup RLE
+ *
+ * Second stage over the tokens of \ref RLE_encode. The token headers are
+ * usually dominated by a few small counts and the values by a few bytes, so
+ * both are coded by canonical Huffman codes. The headers and the values
+ * (run values and literal bytes) form two separate symbol streams with their
+ * own codes. The two length bytes of a stored block follow its header in the
+ * header stream. The code length is limited to 11 bits, which lets the decoder
+ * look up one or two symbols at once in a table of 2048 entries.
+ *
+ * The encoded data have the following layout, the integers are 32 bit little
+ * endian:
+ *
+ * field           | content
+ * ----------------|-----------------------------------------------------------
+ * size            | number of decoded bytes
+ * headers         | number of tokens
+ * values          | number of run values and literal bytes
+ * lengths         | 256 code lengths of header symbols, two per byte
+ * bytes           | size of header bitstream
+ * bitstream       | header codes, most significant bit first
+ * lengths         | 256 code lengths of value symbols, two per byte
+ * bytes           | size of value bitstream
+ * bitstream       | value codes, most significant bit first
+ *
+ * The tables take 264 bytes, so the coding pays off for larger data only.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_ENTROPY_H
+#define RLE_ENTROPY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Encodes \a in array by \ref RLE_encode and codes the tokens by Huffman
+ * codes. The result is allocated on heap the same way as in
+ * \ref RLE_encode.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  result  Pointer to RLE_Data structure, where the encoded data
+ * will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encode_entropy(const uint8_t *in, uint32_t len,
+                             RLE_Data *result);
+
+/*! Decodes data encoded by \ref RLE_encode_entropy. The result is allocated on
+ * heap the same way as in \ref RLE_decode.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  result  Pointer to RLE_Data structure, where the decoded data
+ * will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_entropy(const uint8_t *in, uint32_t len,
+                             RLE_Data *result);
+
+/*! \} */
+#endif  // RLE_ENTROPY_H
@@ -0,0 +1,86 @@
+/*!
+ * \file    rle_estimate.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of RLE compressibility estimation.
+ *
+ * \defgroup RLE_ESTIMATE  RLE compressibility estimation
+ * \ingroup RLE
+ *
+ * The estimation predicts the encoded size of the data for each encoding mode
+ * without encoding the whole data. A fixed number of windows spread evenly
+ * over the data is sampled, each window is tokenized and the costs of the
+ * sampled windows are extrapolated to the whole data. The work is
+ * proportional to the sampled size, not to the data size.
+ *
+ * The error bound is two standard errors of the mean window cost, so the
+ * extrapolated size lies within the bound with about 95 % probability,
+ * provided the windows are representative. At least two windows are needed to
+ * get the bound. Every window is tokenized once and its tokens serve the costs
+ * of all modes.
+ *
+ * Data, which fit to one window, are sampled completely and get zero error
+ * bound, their estimated sizes are exact. Larger data are sampled by at most
+ * one eighth, the windows are shrunk down to 256 bytes and then reduced to stay
+ * within it, so the estimation remains a small fraction of a real encode.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_ESTIMATE_H
+#define RLE_ESTIMATE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Encoding modes covered by the estimation. */
+typedef enum {
+  RLE_MODE_BASIC = 0,   /*!< \ref RLE_encode. */
+  RLE_MODE_HYBRID = 1,  /*!< \ref RLE_hybrid_encode with automatic width. */
+  RLE_MODE_ENTROPY = 2, /*!< \ref RLE_encode_entropy. */
+  RLE_MODE_COUNT        /*!< Number of modes. */
+} RLE_Mode;
+
+/*! Options of the estimation, zero selects the default value. */
+typedef struct {
+  uint32_t windowSize; /*!< Size of sampled window, 4096 by default. */
+  uint32_t windows;    /*!< Number of sampled windows, 16 by default. */
+} RLE_EstimateOptions;
+
+/*! Result of the estimation. */
+typedef struct {
+  uint64_t size[RLE_MODE_COUNT];  /*!< Estimated encoded size of each mode. */
+  uint64_t error[RLE_MODE_COUNT]; /*!< Error bound of each estimated size. */
+  uint64_t runs;                  /*!< Estimated number of runs. */
+  uint64_t sampled;               /*!< Number of sampled bytes. */
+} RLE_Estimate;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Estimates the encoded size of \a in array for every encoding mode.
+ *
+ * \param[in]   in        Input array.
+ * \param[in]   len       Length of input array.
+ * \param[in]   options   Sampling options, NULL for defaults.
+ * \param[out]  estimate  Estimated sizes and their error bounds.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_estimate(const uint8_t *in, uint32_t len,
+                       const RLE_EstimateOptions *options,
+                       RLE_Estimate *estimate);
+
+/*! \} */
+#endif  // RLE_ESTIMATE_H
@@ -0,0 +1,56 @@
+/*!
+ * \file    rle_fd.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of RLE decoding directly to file descriptors.
+ *
+ * \defgroup RLE_FD  RLE file descriptor output
+ * \ingroup RLE
+ *
+ * Decoding to a file through \ref RLE_decode materializes the whole decoded
+ * buffer first and then copies it once more while writing. The functions in
+ * this module skip the intermediate buffer. Literal blocks are written straight
+ * from the encoded input and runs from shared buffers pre-filled with the
+ * repeated value, everything is flushed by batched \c writev calls.
+ *
+ * The module is available on POSIX systems only.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_FD_H
+#define RLE_FD_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Decodes RLE \a in byte array and writes the decoded data to the file
+ * descriptor \a fd. The input is validated before anything is written, so
+ * malformed input produces no output.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   fd      File descriptor opened for writing.
+ * \param[out]  written Number of written bytes, may be NULL.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_fd(const uint8_t *in, uint32_t len, int fd,
+                        uint64_t *written);
+
+/*! \} */
+#endif  // RLE_FD_H
@@ -0,0 +1,92 @@
+/*!
+ * \file    rle_file.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of RLE coding of files within a memory budget.
+ *
+ * \defgroup RLE_FILE  RLE file coding
+ * \ingroup RLE
+ *
+ * \ref RLE_encode and \ref RLE_decode need the whole input and the whole
+ * output in memory. The functions in this module read the input file in
+ * chunks, code them by the resumable coder of \ref RLE_STREAM and write the
+ * result right away, so the memory does not depend on the file size.
+ *
+ * All buffers and the coder state are taken from one allocation, whose size
+ * never exceeds the memory budget. The chunk size is derived from the budget,
+ * the larger chunks the fewer calls of the stdio functions. The coding runs
+ * in the calling thread, the budget does not cover the buffers of the FILE
+ * streams, which are owned by the caller.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_FILE_H
+#define RLE_FILE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Options of file coding, zero selects the default value. */
+typedef struct {
+  uint64_t maxMemory; /*!< Memory budget in bytes, 4 MiB by default. */
+} RLE_FileOptions;
+
+/* Exported constants --------------------------------------------------------*/
+/*! Default memory budget of file coding. */
+#define RLE_FILE_DEFAULT_MEMORY (4u << 20)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Returns the smallest memory budget accepted by the file coding.
+ *
+ * \return Memory budget in bytes.
+ */
+uint64_t RLE_file_min_memory(void);
+
+/*! Encodes the rest of \a in file to the \a out file. The output is the same
+ * as of \ref RLE_encode of the whole input.
+ *
+ * \param[in]   in        Input file opened for reading.
+ * \param[in]   out       Output file opened for writing.
+ * \param[in]   options   Memory budget, NULL for defaults.
+ * \param[out]  read      Number of read bytes, may be NULL.
+ * \param[out]  written   Number of written bytes, may be NULL.
+ *
+ * \return If error occure, the input is empty or the budget is lower than
+ * \ref RLE_file_min_memory the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encode_file(FILE *in, FILE *out, const RLE_FileOptions *options,
+                          uint64_t *read, uint64_t *written);
+
+/*! Decodes the rest of \a in file to the \a out file. The tokens are written
+ * as soon as they are decoded, so part of the output may be written before
+ * malformed input is detected.
+ *
+ * \param[in]   in        Encoded file opened for reading.
+ * \param[in]   out       Output file opened for writing.
+ * \param[in]   options   Memory budget, NULL for defaults.
+ * \param[out]  read      Number of read bytes, may be NULL.
+ * \param[out]  written   Number of written bytes, may be NULL.
+ *
+ * \return If error occure, the input is empty or the budget is lower than
+ * \ref RLE_file_min_memory the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_file(FILE *in, FILE *out, const RLE_FileOptions *options,
+                          uint64_t *read, uint64_t *written);
+
+/*! \} */
+#endif  // RLE_FILE_H
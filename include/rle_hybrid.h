@@ -0,0 +1,106 @@
+/*!
+ * \file    rle_hybrid.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of hybrid RLE / bit-packing codec.
+ *
+ * \defgroup RLE_HYBRID  RLE hybrid codec
+ * \ingroup RLE
+ *
+ * Hybrid codec for columns with small range of values (enumerations, flags,
+ * dictionary codes), where the byte oriented \ref RLE_encode wastes space on
+ * short runs. It follows the Parquet RLE / bit-packing hybrid encoding. Every
+ * value uses only the given bit width and the stream alternates between two
+ * kinds of sections, each starting with an ULEB128 varint header:
+ *
+ * header          | section
+ * ----------------|-----------------------------------------------------------
+ * (count << 1)    | run of \a count values, the value is stored in one byte
+ * (groups << 1)|1 | \a groups groups of 8 values bit-packed LSB first, every
+ *                 | group takes exactly bit width bytes
+ *
+ * The encoded stream starts with the bit width byte followed by the number of
+ * values stored as 32 bit little endian integer, the last bit-packed group is
+ * padded by zeros.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_HYBRID_H
+#define RLE_HYBRID_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Returns the minimal bit width, which can hold every value of \a in array.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   len     Length of input array.
+ *
+ * \return Bit width in range 1 to 8.
+ */
+uint8_t RLE_hybrid_bit_width(const uint8_t *in, uint32_t len);
+
+/*! Encodes \a in array using the hybrid RLE / bit-packing encoding. Runs of at
+ * least 8 equal values are stored as runs, other values are bit-packed. The
+ * result is allocated on heap the same way as in \ref RLE_encode.
+ *
+ * \param[in]   in        Input array.
+ * \param[in]   len       Length of input array.
+ * \param[in]   bitWidth  Number of bits per value (1 to 8), zero selects the
+ * minimal width for the data.
+ * \param[out]  result    Pointer to RLE_Data structure, where result will be
+ * stored.
+ *
+ * \return If error occure or any value does not fit into \a bitWidth bits the
+ * \ref RLE_ERROR is returned, \ref RLE_OK otherwise.
+ */
+RLE_State RLE_hybrid_encode(const uint8_t *in, uint32_t len, uint8_t bitWidth,
+                            RLE_Data *result);
+
+/*! Decodes data encoded by \ref RLE_hybrid_encode. The result is allocated on
+ * heap the same way as in \ref RLE_decode.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  result  Pointer to RLE_Data structure, where the decoded result
+ * will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_hybrid_decode(const uint8_t *in, uint32_t len, RLE_Data *result);
+
+/*! Decodes data encoded by \ref RLE_hybrid_encode the same way as
+ * \ref RLE_hybrid_decode, but refuses to produce more data than allowed by
+ * \a options. A run section of a few bytes may describe gigabytes, so the
+ * decoded size stored in the header is checked before anything is allocated.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   options Decoding limits, NULL means no limits.
+ * \param[out]  result  Pointer to RLE_Data structure, where the decoded result
+ * will be stored.
+ *
+ * \return \ref RLE_ERROR_LIMIT if any limit is exceeded, \ref RLE_ERROR for
+ * malformed input or wrong arguments, \ref RLE_OK otherwise.
+ */
+RLE_State RLE_hybrid_decode_ex(const uint8_t *in, uint32_t len,
+                               const RLE_DecodeOptions *options,
+                               RLE_Data *result);
+
+/*! \} */
+#endif  // RLE_HYBRID_H
@@ -0,0 +1,219 @@
+/*!
+ * \file    rle_io.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of RLE coding between generic sources and sinks.
+ *
+ * \defgroup RLE_IO  RLE sources and sinks
+ * \ingroup RLE
+ *
+ * The codec reads its input from a \ref RLE_Source and writes its output to
+ * a \ref RLE_Sink, i.e. a callback with a context. Built-in adapters cover
+ * memory, stdio files, file descriptors and memory mapped files, other
+ * sources and sinks are implemented by the caller. \ref RLE_encode_io and
+ * \ref RLE_decode_io stream the data between any pair of them in chunks of
+ * \ref RLE_IO_CHUNK_SIZE bytes by the resumable coder of \ref RLE_STREAM, so
+ * the buffering is implemented once for all of them.
+ *
+ * Sources backed by memory return pointers to their own data instead of
+ * copying them to the buffer of the codec.
+ *
+ * The file descriptor and memory mapped adapters are available on POSIX
+ * systems only.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_IO_H
+#define RLE_IO_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Reads next data of the source. The data are either read to \a buffer or
+ * provided from the memory of the source, they stay valid until the next
+ * call.
+ *
+ * \param[in]   context   Context of the source.
+ * \param[out]  data      Pointer to the read data.
+ * \param[out]  size      Size of the read data, zero at the end of source.
+ * \param[out]  buffer    Buffer, which may be used for the read data.
+ * \param[in]   capacity  Size of \a buffer, the maximal size of read data.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+typedef RLE_State (*RLE_ReadFnc)(void *context, const uint8_t **data,
+                                 uint32_t *size, uint8_t *buffer,
+                                 uint32_t capacity);
+
+/*! Writes all \a size bytes of \a data to the sink.
+ *
+ * \param[in]   context   Context of the sink.
+ * \param[in]   data      Written data.
+ * \param[in]   size      Size of data, never zero.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+typedef RLE_State (*RLE_WriteFnc)(void *context, const uint8_t *data,
+                                  uint32_t size);
+
+/*! Releases the context of a source or sink, may be NULL. */
+typedef void (*RLE_CloseFnc)(void *context);
+
+/*! Source of data. */
+typedef struct {
+  RLE_ReadFnc read;   /*!< Reads the next data. */
+  RLE_CloseFnc close; /*!< Releases the context, may be NULL. */
+  void *context;      /*!< Context of the callbacks. */
+} RLE_Source;
+
+/*! Destination of data. */
+typedef struct {
+  RLE_WriteFnc write; /*!< Writes the data. */
+  RLE_CloseFnc close; /*!< Releases the context, may be NULL. */
+  void *context;      /*!< Context of the callbacks. */
+} RLE_Sink;
+
+/* Exported constants --------------------------------------------------------*/
+/*! Size of the chunks read from sources and of the decoded tiles. */
+#define RLE_IO_CHUNK_SIZE (64u << 10)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Creates source of \a size bytes of \a data, which must stay valid until
+ * the source is closed.
+ *
+ * \param[in]   data      Source data, may be NULL if \a size is zero.
+ * \param[in]   size      Size of data.
+ * \param[out]  source    Created source.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_source_memory(const uint8_t *data, uint64_t size,
+                            RLE_Source *source);
+
+/*! Creates source reading the rest of \a file. The file is not closed by
+ * \ref RLE_source_close.
+ *
+ * \param[in]   file      File opened for reading.
+ * \param[out]  source    Created source.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_source_file(FILE *file, RLE_Source *source);
+
+/*! Closes the \a source.
+ *
+ * \param[in,out] source  Closed source.
+ */
+void RLE_source_close(RLE_Source *source);
+
+/*! Creates sink collecting the data to \a result allocated on heap. The
+ * result is valid after each write, the caller frees its data.
+ *
+ * \param[out]  result    Collected data, empty until the first write.
+ * \param[out]  sink      Created sink.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_sink_memory(RLE_Data *result, RLE_Sink *sink);
+
+/*! Creates sink writing to \a file. The file is not closed by
+ * \ref RLE_sink_close.
+ *
+ * \param[in]   file      File opened for writing.
+ * \param[out]  sink      Created sink.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_sink_file(FILE *file, RLE_Sink *sink);
+
+/*! Closes the \a sink.
+ *
+ * \param[in,out] sink    Closed sink.
+ */
+void RLE_sink_close(RLE_Sink *sink);
+
+#ifndef _WIN32
+/*! Creates source reading the file descriptor \a fd until its end. The
+ * descriptor is not closed by \ref RLE_source_close.
+ *
+ * \param[in]   fd        File descriptor opened for reading.
+ * \param[out]  source    Created source.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_source_fd(int fd, RLE_Source *source);
+
+/*! Creates source of the file at \a path mapped to memory. The mapping is
+ * released by \ref RLE_source_close.
+ *
+ * \param[in]   path      Path to the file.
+ * \param[out]  source    Created source.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_source_mmap(const char *path, RLE_Source *source);
+
+/*! Creates sink writing to the file descriptor \a fd. The descriptor is not
+ * closed by \ref RLE_sink_close.
+ *
+ * \param[in]   fd        File descriptor opened for writing.
+ * \param[out]  sink      Created sink.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_sink_fd(int fd, RLE_Sink *sink);
+#endif
+
+/*! Encodes all data of \a source to \a sink. The output is the same as of
+ * \ref RLE_encode of the whole input.
+ *
+ * \param[in]   source    Source of input data.
+ * \param[in]   sink      Destination of encoded data.
+ * \param[out]  read      Number of read bytes, may be NULL.
+ * \param[out]  written   Number of written bytes, may be NULL.
+ *
+ * \return If error occure or the source is empty the \ref RLE_ERROR is
+ * returned, \ref RLE_OK otherwise.
+ */
+RLE_State RLE_encode_io(const RLE_Source *source, const RLE_Sink *sink,
+                        uint64_t *read, uint64_t *written);
+
+/*! Decodes all data of \a source to \a sink. The tokens are written as soon
+ * as they are decoded, so part of the output may be written before malformed
+ * input is detected.
+ *
+ * \param[in]   source    Source of encoded data.
+ * \param[in]   sink      Destination of decoded data.
+ * \param[out]  read      Number of read bytes, may be NULL.
+ * \param[out]  written   Number of written bytes, may be NULL.
+ *
+ * \return If error occure or the source is empty the \ref RLE_ERROR is
+ * returned, \ref RLE_OK otherwise.
+ */
+RLE_State RLE_decode_io(const RLE_Source *source, const RLE_Sink *sink,
+                        uint64_t *read, uint64_t *written);
+
+/*! \} */
+#endif  // RLE_IO_H
@@ -0,0 +1,156 @@
+/*!
+ * \file    rle_query.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of queries evaluated directly on RLE encoded data.
+ *
+ * \defgroup RLE_QUERY  RLE compressed-domain queries
+ * \ingroup RLE
+ *
+ * The functions in this module compute aggregates of decoded data directly
+ * from the tokens of encoded data, without expanding them. A run token costs
+ * O(1) regardless of its length, only literal blocks are visited byte by byte.
+ * All functions validate the encoded data and return \ref RLE_ERROR for
+ * malformed input, in which case the output arguments are not modified.
+ *
+ * Two encoded streams are compared by walking their tokens in lockstep. Equal
+ * runs are skipped in O(1) regardless of how the streams are tokenized, bytes
+ * are compared one by one only inside literal blocks. Each stream is read
+ * once and validated during the walk. \ref RLE_equal and
+ * \ref RLE_first_difference stop at the first difference, including the end
+ * of the shorter data, so tokens behind it are not validated.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_QUERY_H
+#define RLE_QUERY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Range of decoded data. */
+typedef struct {
+  uint64_t offset; /*!< Offset of the first byte of the range. */
+  uint64_t length; /*!< Number of bytes in the range. */
+} RLE_Range;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Counts occurrences of \a value in the decoded data.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   value   Searched value.
+ * \param[out]  count   Number of occurrences.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_count(const uint8_t *in, uint32_t len, uint8_t value,
+                    uint64_t *count);
+
+/*! Computes the sum of all bytes of the decoded data.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  sum     Sum of decoded bytes.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_sum(const uint8_t *in, uint32_t len, uint64_t *sum);
+
+/*! Computes the histogram of the decoded data, i.e. the number of occurrences
+ * of every byte value.
+ *
+ * \param[in]   in        Encoded input array.
+ * \param[in]   len       Length of input array.
+ * \param[out]  histogram Array of 256 counters indexed by the byte value.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_histogram(const uint8_t *in, uint32_t len,
+                        uint64_t histogram[256]);
+
+/*! Finds the first occurrence of \a value in the decoded data. The scan stops
+ * at the first match, the rest of input is not validated.
+ *
+ * \param[in]   in        Encoded input array.
+ * \param[in]   len       Length of input array.
+ * \param[in]   value     Searched value.
+ * \param[out]  position  Offset of the first occurrence in the decoded data,
+ * or the size of decoded data if the value is not present.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_find(const uint8_t *in, uint32_t len, uint8_t value,
+                   uint64_t *position);
+
+/*! Checks whether two encoded streams decode to the same data.
+ *
+ * \param[in]   first       First encoded array.
+ * \param[in]   firstLen    Length of the first array.
+ * \param[in]   second      Second encoded array.
+ * \param[in]   secondLen   Length of the second array.
+ * \param[out]  equal       True if the decoded data are equal.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_equal(const uint8_t *first, uint32_t firstLen,
+                    const uint8_t *second, uint32_t secondLen, bool *equal);
+
+/*! Finds the first offset where the decoded data of two encoded streams
+ * differ. If one decoded data are prefix of the other, the offset is the size
+ * of the shorter ones.
+ *
+ * \param[in]   first       First encoded array.
+ * \param[in]   firstLen    Length of the first array.
+ * \param[in]   second      Second encoded array.
+ * \param[in]   secondLen   Length of the second array.
+ * \param[out]  offset      Offset of the first difference, UINT64_MAX if the
+ * decoded data are equal.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_first_difference(const uint8_t *first, uint32_t firstLen,
+                               const uint8_t *second, uint32_t secondLen,
+                               uint64_t *offset);
+
+/*! Lists all ranges where the decoded data of two encoded streams differ. If
+ * the decoded sizes differ, the tail of the longer data is reported as the
+ * last range. The array of ranges is allocated on heap and must be freed by
+ * the caller, it is NULL if the data are equal.
+ *
+ * \param[in]   first       First encoded array.
+ * \param[in]   firstLen    Length of the first array.
+ * \param[in]   second      Second encoded array.
+ * \param[in]   secondLen   Length of the second array.
+ * \param[out]  ranges      Heap allocated array of differing ranges.
+ * \param[out]  count       Number of ranges.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_diff(const uint8_t *first, uint32_t firstLen,
+                   const uint8_t *second, uint32_t secondLen,
+                   RLE_Range **ranges, uint32_t *count);
+
+/*! \} */
+#endif  // RLE_QUERY_H
@@ -0,0 +1,176 @@
+/*!
+ * \file    rle_stream.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of resumable RLE encoder and decoder.
+ *
+ * \defgroup RLE_STREAM  RLE streaming interface
+ * \ingroup RLE
+ *
+ * The encoder and decoder in this module process the data in pieces of any
+ * size. Their whole state is kept in a small structure owned by the caller, so
+ * no memory is allocated and the processing may be suspended and resumed at
+ * any byte. The encoder produces exactly the same data as \ref RLE_encode
+ * regardless of how the input is split.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_STREAM_H
+#define RLE_STREAM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Size of the buffer keeping the input bytes, whose token is not decided. */
+#define RLE_ENCODER_CARRY_SIZE (8208)
+
+/*! State of the resumable encoder. */
+typedef struct {
+  uint8_t carry[RLE_ENCODER_CARRY_SIZE]; /*!< Bytes of the undecided token. */
+  uint32_t carryLen;                     /*!< Number of bytes in carry. */
+} RLE_Encoder;
+
+/*! State of the resumable decoder. */
+typedef struct {
+  uint16_t remaining;  /*!< Bytes of current token not produced yet. */
+  uint8_t value;       /*!< Value of current run. */
+  uint8_t lengthBytes; /*!< Bytes of stored block length not read yet. */
+  bool literal;        /*!< True if current token is literal block. */
+  bool needValue;      /*!< True if the run value was not read yet. */
+} RLE_Decoder;
+
+/*! Consumer of decoded data called by \ref RLE_decode_cb.
+ *
+ * \param[in]   context   Context passed to \ref RLE_decode_cb.
+ * \param[in]   data      Decoded data, valid until the function returns.
+ * \param[in]   size      Size of decoded data, never zero.
+ *
+ * \return Returns false to stop decoding.
+ */
+typedef bool (*RLE_Consumer)(void *context, const uint8_t *data,
+                             uint32_t size);
+
+/* Exported constants --------------------------------------------------------*/
+/*! Size of the tile allocated by \ref RLE_decode_cb if the caller supplies
+ * none. The tile fits to the L2 cache together with the consumer data. */
+#define RLE_DECODE_TILE_SIZE (64u << 10)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Initializes the \a encoder to the start of new data.
+ *
+ * \param[out]  encoder   Encoder state.
+ */
+void RLE_encoder_init(RLE_Encoder *encoder);
+
+/*! Returns the size of output buffer sufficient for one call of
+ * \ref RLE_encoder_feed with \a len bytes or \ref RLE_encoder_finish.
+ *
+ * \param[in]   len     Number of fed bytes.
+ *
+ * \return Size of output buffer in bytes.
+ */
+uint64_t RLE_encoder_bound(uint32_t len);
+
+/*! Encodes next \a len bytes of data. The tokens, whose end depends on the
+ * following data, are kept in the encoder and written by the next call.
+ *
+ * \param[in,out] encoder   Encoder state.
+ * \param[in]     in        Input array, may be NULL if len is zero.
+ * \param[in]     len       Length of input array.
+ * \param[out]    out       Output buffer of at least
+ * \ref RLE_encoder_bound bytes.
+ * \param[out]    outLen    Number of bytes written to \a out.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encoder_feed(RLE_Encoder *encoder, const uint8_t *in,
+                           uint32_t len, uint8_t *out, uint32_t *outLen);
+
+/*! Writes the tokens kept in the \a encoder and initializes it for new data.
+ *
+ * \param[in,out] encoder   Encoder state.
+ * \param[out]    out       Output buffer of at least
+ * \ref RLE_encoder_bound (0) bytes.
+ * \param[out]    outLen    Number of bytes written to \a out.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encoder_finish(RLE_Encoder *encoder, uint8_t *out,
+                             uint32_t *outLen);
+
+/*! Initializes the \a decoder to the start of new data.
+ *
+ * \param[out]  decoder   Decoder state.
+ */
+void RLE_decoder_init(RLE_Decoder *decoder);
+
+/*! Decodes encoded bytes from \a in until the input is exhausted or \a out is
+ * full. The consumed bytes are removed from \a in and \a inLen. If output is
+ * full, the call must be repeated, possibly with no input, until it writes
+ * fewer than \a outSize bytes.
+ *
+ * \param[in,out] decoder   Decoder state.
+ * \param[in,out] in        Pointer to the encoded input.
+ * \param[in,out] inLen     Length of the encoded input.
+ * \param[out]    out       Output buffer.
+ * \param[in]     outSize   Size of output buffer.
+ * \param[out]    outLen    Number of bytes written to \a out.
+ *
+ * \return If malformed token is detected the \ref RLE_ERROR is returned,
+ * \ref RLE_OK otherwise.
+ */
+RLE_State RLE_decoder_feed(RLE_Decoder *decoder, const uint8_t **in,
+                           uint32_t *inLen, uint8_t *out, uint32_t outSize,
+                           uint32_t *outLen);
+
+/*! Checks that the data ended at a token boundary and no decoded byte is
+ * pending in the \a decoder.
+ *
+ * \param[in]   decoder   Decoder state.
+ *
+ * \return If the data are truncated the \ref RLE_ERROR is returned,
+ * \ref RLE_OK otherwise.
+ */
+RLE_State RLE_decoder_finish(const RLE_Decoder *decoder);
+
+/*! Decodes RLE \a in byte array tile by tile. Each time the tile is full,
+ * the \a consumer is called with it, the last tile may be partial. The
+ * decoded data thus stay in the cache between the decoder and the consumer
+ * and the memory does not depend on the size of decoded data.
+ *
+ * The input is not validated in advance, the consumer may receive part of
+ * the data before malformed token is detected.
+ *
+ * \param[in]   in        Encoded input array.
+ * \param[in]   len       Length of input array.
+ * \param[out]  tile      Tile buffer, NULL to allocate one of
+ * \ref RLE_DECODE_TILE_SIZE bytes.
+ * \param[in]   tileSize  Size of \a tile, ignored if \a tile is NULL.
+ * \param[in]   consumer  Consumer of decoded tiles.
+ * \param[in]   context   Context passed to the consumer, may be NULL.
+ * \param[out]  decoded   Number of bytes passed to the consumer, may be NULL.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise, also if the consumer stopped decoding.
+ */
+RLE_State RLE_decode_cb(const uint8_t *in, uint32_t len, uint8_t *tile,
+                        uint32_t tileSize, RLE_Consumer consumer,
+                        void *context, uint64_t *decoded);
+
+/*! \} */
+#endif  // RLE_STREAM_H
@@ -0,0 +1,163 @@
+/*!
+ * \file    rle_transform.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of RLE coding with reversible pre-transforms.
+ *
+ * \defgroup RLE_TRANSFORM  RLE transforms
+ * \ingroup RLE
+ *
+ * Slowly changing multi-byte values, e.g. counters, timestamps or sensor
+ * samples, rarely contain runs of equal bytes. Their differences do. The
+ * functions in this module transform the data in small tiles, which stay in
+ * cache, and feed each tile directly to the resumable encoder, so the
+ * transformed data are never stored as a whole. Decoding applies the inverse
+ * transform to each decoded tile right after it is produced.
+ *
+ * Several transforms may be chained to a pipeline. All stages of the pipeline
+ * are applied to one tile before the next tile is read, so the data pass the
+ * memory once regardless of the number of stages. The pipeline is stored in
+ * the header of encoded data and decoding applies the inverse stages in the
+ * reverse order.
+ *
+ * The elements are unsigned little endian integers, the differences are
+ * computed modulo the element range. Trailing bytes, which do not form whole
+ * element, are stored unchanged. The tiles have fixed size of
+ * \ref RLE_TRANSFORM_TILE_SIZE bytes, which is part of the format, because
+ * the byte shuffle reorders the bytes inside a tile.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef RLE_TRANSFORM_H
+#define RLE_TRANSFORM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "rle.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! Options of delta transform. */
+typedef struct {
+  uint8_t width; /*!< Element width in bytes, 1, 2, 4 or 8. */
+  uint8_t order; /*!< 1 for delta, 2 for delta-of-delta. */
+} RLE_DeltaOptions;
+
+/*! Type of pipeline stage. */
+typedef enum {
+  RLE_STAGE_SHUFFLE = 1, /*!< Groups the n-th bytes of all elements. */
+  RLE_STAGE_DELTA = 2,   /*!< Differences of consecutive elements. */
+  RLE_STAGE_XOR = 3,     /*!< XOR of consecutive elements. */
+  RLE_STAGE_MTF = 4,     /*!< Move-to-front coding of bytes. */
+} RLE_StageType;
+
+/*! One stage of transform pipeline. */
+typedef struct {
+  uint8_t type;  /*!< Stage type, one of \ref RLE_StageType. */
+  uint8_t width; /*!< Element width in bytes, 1, 2, 4 or 8, ignored by MTF. */
+  uint8_t order; /*!< Order of delta stage, ignored by other stages. */
+} RLE_Stage;
+
+/*! Maximal number of stages in the pipeline. */
+#define RLE_PIPELINE_MAX_STAGES (8)
+
+/*! Transform pipeline, the stages are applied from the first one. */
+typedef struct {
+  RLE_Stage stages[RLE_PIPELINE_MAX_STAGES]; /*!< Stages. */
+  uint8_t count;                             /*!< Number of stages. */
+} RLE_Pipeline;
+
+/* Exported constants --------------------------------------------------------*/
+/*! Size of the transformed tile. */
+#define RLE_TRANSFORM_TILE_SIZE (4096)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Encodes differences of consecutive elements of \a in array. The first
+ * element is stored as difference from zero. With the second order the
+ * differences of differences are encoded, so linearly growing values become
+ * a single run. The result is allocated on heap the same way as in
+ * \ref RLE_encode.
+ *
+ * \param[in]   in        Input array.
+ * \param[in]   len       Length of input array.
+ * \param[in]   options   Element width and transform order.
+ * \param[out]  result    Pointer to RLE_Data structure, where the encoded data
+ * will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encode_delta(const uint8_t *in, uint32_t len,
+                           const RLE_DeltaOptions *options, RLE_Data *result);
+
+/*! Decodes data encoded by \ref RLE_encode_delta with the same \a options.
+ * The prefix sums restoring the elements are computed tile by tile while
+ * decoding.
+ *
+ * \param[in]   in        Encoded input array.
+ * \param[in]   len       Length of input array.
+ * \param[in]   options   Element width and transform order.
+ * \param[out]  result    Pointer to RLE_Data structure, where the decoded data
+ * will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_delta(const uint8_t *in, uint32_t len,
+                           const RLE_DeltaOptions *options, RLE_Data *result);
+
+/*! Transforms \a in array by the \a pipeline and encodes the result. The
+ * encoded data start with the number of stages followed by the type, width
+ * and order byte of each stage. The result is allocated on heap the same way
+ * as in \ref RLE_encode.
+ *
+ * \param[in]   in        Input array.
+ * \param[in]   len       Length of input array.
+ * \param[in]   pipeline  Transform stages, the number of stages may be zero.
+ * \param[out]  result    Pointer to RLE_Data structure, where the encoded data
+ * will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_encode_pipeline(const uint8_t *in, uint32_t len,
+                              const RLE_Pipeline *pipeline, RLE_Data *result);
+
+/*! Decodes data encoded by \ref RLE_encode_pipeline. The pipeline is read from
+ * the header of encoded data.
+ *
+ * \param[in]   in        Encoded input array.
+ * \param[in]   len       Length of input array.
+ * \param[out]  result    Pointer to RLE_Data structure, where the decoded data
+ * will be stored.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State RLE_decode_pipeline(const uint8_t *in, uint32_t len,
+                              RLE_Data *result);
+
+/*! Reads the pipeline from the header of data encoded by
+ * \ref RLE_encode_pipeline.
+ *
+ * \param[in]   in        Encoded input array.
+ * \param[in]   len       Length of input array.
+ * \param[out]  pipeline  Stored pipeline.
+ *
+ * \return If the header is not valid the \ref RLE_ERROR is returned,
+ * \ref RLE_OK otherwise.
+ */
+RLE_State RLE_pipeline_read(const uint8_t *in, uint32_t len,
+                            RLE_Pipeline *pipeline);
+
+/*! \} */
+#endif  // RLE_TRANSFORM_H
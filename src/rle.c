@@ -14,54 +14,229 @@
 /* Includes ------------------------------------------------------------------*/
 #include "rle.h"
 
-#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
 
 /* Private types -------------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function declarations ---------------------------------------------*/
+static void decodeTokens(const uint8_t *in, uint32_t len, uint8_t *out,
+                         uint32_t size);
+
 /* Exported functions definitions --------------------------------------------*/
 RLE_State RLE_decode(const uint8_t *in, uint32_t len, RLE_Data *result) {
-  int i = 0;
-  int count = 0;
-
-  while (in[i] < len) {
-    if(in[i] == in[i-1]) {
-      while (count > 0) {
-        count--;
-      }
+  return RLE_decode_ex(in, len, NULL, result);
+}
+
+RLE_State RLE_decode_ex(const uint8_t *in, uint32_t len,
+                        const RLE_DecodeOptions *options, RLE_Data *result) {
+  if (in == NULL || len == 0 || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t size;
+  RLE_State state =
+      rleScanDecodedSize(in, len, rleDecodeLimit(len, options), &size);
+  if (state != RLE_OK) {
+    return state;
+  }
+
+  uint8_t *data = malloc(size);
+  if (data == NULL) {
+    return RLE_ERROR;
+  }
+
+  decodeTokens(in, len, data, (uint32_t)size);
+  result->data = data;
+  result->size = (uint32_t)size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_decoded_size(const uint8_t *in, uint32_t len, uint32_t *size) {
+  if (in == NULL || len == 0 || size == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t total;
+  RLE_State state = rleScanDecodedSize(in, len, UINT32_MAX, &total);
+  if (state == RLE_OK) {
+    *size = (uint32_t)total;
+  }
+
+  return state;
+}
+
+RLE_State RLE_decode_into(const uint8_t *in, uint32_t len, uint8_t *out,
+                          uint32_t size, uint32_t *written) {
+  if (in == NULL || len == 0 || out == NULL || written == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t total;
+  RLE_State state = rleScanDecodedSize(in, len, size, &total);
+  if (state != RLE_OK) {
+    return state;
+  }
+
+  decodeTokens(in, len, out, (uint32_t)total);
+  *written = (uint32_t)total;
+
+  return RLE_OK;
+}
+
+uint64_t RLE_encode_bound(uint32_t len) {
+  return rleEncodeBound(len);
+}
+
+RLE_State RLE_encode(const uint8_t *in, uint32_t len, RLE_Data *result) {
+  if (in == NULL || len == 0 || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t bound = rleEncodeBound(len);
+  if (bound > UINT32_MAX) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data = malloc(bound);
+  if (data == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t consumed;
+  uint32_t size = rleEncodeTokens(in, len, data, true, &consumed);
+  uint8_t *p = realloc(data, size);
+
+  result->data = p != NULL ? p : data;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_encode_into(const uint8_t *in, uint32_t len, uint8_t *out,
+                          uint64_t size, uint32_t *written) {
+  if (in == NULL || len == 0 || out == NULL || written == NULL ||
+      size < rleEncodeBound(len)) {
+    return RLE_ERROR;
+  }
+
+  uint32_t consumed;
+  *written = rleEncodeTokens(in, len, out, true, &consumed);
+
+  return RLE_OK;
+}
+
+/* Internal functions definitions --------------------------------------------*/
+uint64_t rleDecodeLimit(uint32_t len, const RLE_DecodeOptions *options) {
+  uint64_t limit = UINT32_MAX;
+
+  if (options != NULL) {
+    if (options->maxOutputSize != 0 && options->maxOutputSize < limit) {
+      limit = options->maxOutputSize;
+    }
+    if (options->maxRatio != 0 && (uint64_t)options->maxRatio * len < limit) {
+      limit = (uint64_t)options->maxRatio * len;
+    }
+  }
+
+  return limit;
+}
+
+RLE_State rleScanDecodedSize(const uint8_t *in, uint32_t len, uint64_t limit,
+                             uint64_t *size) {
+  uint64_t total = 0;
+  uint32_t i = 0;
+
+  while (i < len) {
+    RleToken token;
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+
+    total += token.count;
+    if (total > limit) {
+      return RLE_ERROR_LIMIT;
+    }
+  }
+
+  *size = total;
+  return RLE_OK;
+}
+
+RLE_State rleDecodeChecked(const uint8_t *in, uint32_t len, uint8_t *out,
+                           uint32_t size, uint32_t *written) {
+  uint32_t i = 0;
+  uint32_t produced = 0;
+
+  while (i < len) {
+    RleToken token;
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+
+    uint32_t room = size - produced;
+    if (token.count > room) {
+      return RLE_ERROR_LIMIT;
+    }
+    if (token.literal) {
+      uint32_t avail = (uint32_t)(&in[len] - token.data);
+      rleCopyLiteral(&out[produced], room, token.data, avail, token.count);
     } else {
-      result->size = count;
-      result->data = (uint8_t *)&in[i];;
+      rleFillRun(&out[produced], room, token.data[0], token.count);
     }
-    i++;
+    produced += token.count;
   }
 
-  return RLE_ERROR;
+  *written = produced;
+  return RLE_OK;
 }
 
-RLE_State RLE_encode(const uint8_t *in, uint32_t len, RLE_Data *result) {
-  int count;
-  int size = 0;
-
-  for (uint32_t i = 0; i < len; i++) {
-    count = 1;
-    size++;
-    while (i + 1 < len && in[i] == in[i + 1]) {
-      if (count >= 255) {
-        printf("daco");
-        break;
-      }
-      count++;
-      i++;
+uint32_t rleEncodeTokens(const uint8_t *in, uint32_t len, uint8_t *out,
+                         bool final, uint32_t *consumed) {
+  uint8_t *o = out;
+  uint32_t i = 0;
+
+  while (i < len) {
+    uint32_t j = rleEncodeToken(in, len, i, final, &o);
+    if (j == i) {
+      break;
     }
-    printf("% d, %c,", count, in[i]);
-    result->data = (uint8_t *)&in[i];
-    result->size = size;
+    i = j;
   }
-  printf("\n%d", size);
 
-  return RLE_ERROR;
+  *consumed = i;
+  return (uint32_t)(o - out);
 }
 
 /* Private function definitions ----------------------------------------------*/
+/*! Decodes already validated tokens to the \a out buffer. Short tokens may
+ * write a few bytes behind their end, which the following tokens overwrite.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  out     Output buffer.
+ * \param[in]   size    Size of decoded data.
+ */
+static void decodeTokens(const uint8_t *in, uint32_t len, uint8_t *out,
+                         uint32_t size) {
+  uint32_t i = 0;
+  uint32_t produced = 0;
+
+  while (i < len) {
+    RleToken token;
+    rleReadToken(in, len, &i, &token);
+
+    uint32_t room = size - produced;
+    if (token.literal) {
+      uint32_t avail = (uint32_t)(&in[len] - token.data);
+      rleCopyLiteral(&out[produced], room, token.data, avail, token.count);
+    } else {
+      rleFillRun(&out[produced], room, token.data[0], token.count);
+    }
+    produced += token.count;
+  }
+}
@@ -0,0 +1,229 @@
+/*!
+ * \file    rle_batch.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of batch RLE coding of many small buffers.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_batch.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! One buffer being coded. */
+typedef struct {
+  const uint8_t *in; /*!< Input buffer. */
+  uint32_t len;      /*!< Length of input buffer. */
+  uint32_t pos;      /*!< Position of the next token in input. */
+  uint8_t *start;    /*!< Start of the output. */
+  uint8_t *out;      /*!< Position of the next output byte. */
+  uint32_t item;     /*!< Index of the buffer in the batch. */
+} Lane;
+
+/* Private macros ------------------------------------------------------------*/
+/*! Number of buffers coded at once. */
+#define BATCH_LANES (4)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static bool validSpans(const RLE_Span *inputs, uint32_t count,
+                       uint64_t *bound);
+static void initLane(Lane *lane, const RLE_Span *input, uint32_t item,
+                     uint8_t *out);
+static void decodeToken(Lane *lane);
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_encode_batch(const RLE_Span *inputs, uint32_t count,
+                           RLE_Data *result, uint32_t *offsets) {
+  if (inputs == NULL || count == 0 || result == NULL || offsets == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t bound;
+  if (!validSpans(inputs, count, &bound) || bound > UINT32_MAX) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data = malloc(bound);
+  if (data == NULL) {
+    return RLE_ERROR;
+  }
+
+  // Each buffer is encoded to its bound sized slot of the arena, the sizes
+  // are kept in the offsets table until the slots are compacted.
+  Lane lanes[BATCH_LANES];
+  uint32_t active = 0;
+  uint32_t next = 0;
+  uint8_t *slot = data;
+
+  while (active > 0 || next < count) {
+    while (active < BATCH_LANES && next < count) {
+      initLane(&lanes[active++], &inputs[next], next, slot);
+      slot += rleEncodeBound(inputs[next++].size);
+    }
+
+    for (uint32_t l = 0; l < active;) {
+      Lane *lane = &lanes[l];
+      if (lane->pos < lane->len) {
+        lane->pos = rleEncodeToken(lane->in, lane->len, lane->pos, true,
+                                   &lane->out);
+        l++;
+      } else {
+        offsets[lane->item] = (uint32_t)(lane->out - lane->start);
+        *lane = lanes[--active];
+      }
+    }
+  }
+
+  uint32_t src = 0;
+  uint32_t dst = 0;
+  for (uint32_t k = 0; k < count; k++) {
+    uint32_t size = offsets[k];
+    memmove(&data[dst], &data[src], size);
+    offsets[k] = dst;
+    dst += size;
+    src += (uint32_t)rleEncodeBound(inputs[k].size);
+  }
+  offsets[count] = dst;
+
+  if (dst == 0) {
+    free(data);
+    data = NULL;
+  } else {
+    uint8_t *p = realloc(data, dst);
+    data = p != NULL ? p : data;
+  }
+
+  result->data = data;
+  result->size = dst;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_decode_batch(const RLE_Span *inputs, uint32_t count,
+                           RLE_Data *result, uint32_t *offsets) {
+  if (inputs == NULL || count == 0 || result == NULL || offsets == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t bound;
+  if (!validSpans(inputs, count, &bound)) {
+    return RLE_ERROR;
+  }
+
+  uint64_t total = 0;
+  for (uint32_t k = 0; k < count; k++) {
+    uint64_t size;
+    if (rleScanDecodedSize(inputs[k].data, inputs[k].size, UINT32_MAX - total,
+                           &size) != RLE_OK) {
+      return RLE_ERROR;
+    }
+    offsets[k] = (uint32_t)total;
+    total += size;
+  }
+  offsets[count] = (uint32_t)total;
+
+  // all results are empty, there is no arena to decode to
+  if (total == 0) {
+    result->data = NULL;
+    result->size = 0;
+    return RLE_OK;
+  }
+
+  uint8_t *data = malloc(total);
+  if (data == NULL) {
+    return RLE_ERROR;
+  }
+
+  Lane lanes[BATCH_LANES];
+  uint32_t active = 0;
+  uint32_t next = 0;
+
+  while (active > 0 || next < count) {
+    while (active < BATCH_LANES && next < count) {
+      initLane(&lanes[active++], &inputs[next], next, &data[offsets[next]]);
+      next++;
+    }
+
+    for (uint32_t l = 0; l < active;) {
+      if (lanes[l].pos < lanes[l].len) {
+        decodeToken(&lanes[l]);
+        l++;
+      } else {
+        lanes[l] = lanes[--active];
+      }
+    }
+  }
+
+  result->data = data;
+  result->size = (uint32_t)total;
+
+  return RLE_OK;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Checks the input buffers and sums the bounds of their encoded sizes.
+ *
+ * \param[in]   inputs  Array of input buffers.
+ * \param[in]   count   Number of input buffers.
+ * \param[out]  bound   Sum of \ref rleEncodeBound of all buffers.
+ *
+ * \return Returns false if any buffer has NULL data and non-zero size.
+ */
+static bool validSpans(const RLE_Span *inputs, uint32_t count,
+                       uint64_t *bound) {
+  *bound = 0;
+
+  for (uint32_t k = 0; k < count; k++) {
+    if (inputs[k].data == NULL && inputs[k].size != 0) {
+      return false;
+    }
+    *bound += rleEncodeBound(inputs[k].size);
+  }
+
+  return true;
+}
+
+/*! Starts coding of the \a input buffer in the \a lane.
+ *
+ * \param[out]  lane    Lane state.
+ * \param[in]   input   Input buffer.
+ * \param[in]   item    Index of the buffer in the batch.
+ * \param[out]  out     Output of the buffer.
+ */
+static void initLane(Lane *lane, const RLE_Span *input, uint32_t item,
+                     uint8_t *out) {
+  lane->in = input->data;
+  lane->len = input->size;
+  lane->pos = 0;
+  lane->start = out;
+  lane->out = out;
+  lane->item = item;
+}
+
+/*! Decodes the next validated token of the \a lane.
+ *
+ * \param[in,out] lane    Lane state.
+ */
+static void decodeToken(Lane *lane) {
+  RleToken token;
+
+  rleReadToken(lane->in, lane->len, &lane->pos, &token);
+  if (token.literal) {
+    memcpy(lane->out, token.data, token.count);
+  } else {
+    memset(lane->out, token.data[0], token.count);
+  }
+  lane->out += token.count;
+}
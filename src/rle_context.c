@@ -0,0 +1,131 @@
+/*!
+ * \file    rle_context.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of RLE coding with a reusable context.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_context.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+/* Exported functions definitions --------------------------------------------*/
+void RLE_context_init(RLE_Context *context, const RLE_DecodeOptions *options) {
+  if (context == NULL) {
+    return;
+  }
+
+  context->buffer = NULL;
+  context->capacity = 0;
+  context->options.maxOutputSize = options != NULL ? options->maxOutputSize : 0;
+  context->options.maxRatio = options != NULL ? options->maxRatio : 0;
+}
+
+RLE_State RLE_context_reserve(RLE_Context *context, uint32_t capacity) {
+  if (context == NULL) {
+    return RLE_ERROR;
+  }
+  if (capacity <= context->capacity) {
+    return RLE_OK;
+  }
+
+  // Doubling keeps the number of allocations low while the results grow. The
+  // old content is not needed, so it is freed instead of reallocated.
+  uint64_t size = (uint64_t)context->capacity * 2;
+  if (size < capacity) {
+    size = capacity;
+  }
+  size = size > UINT32_MAX ? UINT32_MAX : size;
+
+  free(context->buffer);
+  context->buffer = malloc(size);
+  context->capacity = context->buffer != NULL ? (uint32_t)size : 0;
+
+  return context->buffer != NULL ? RLE_OK : RLE_ERROR;
+}
+
+RLE_State RLE_context_encode(RLE_Context *context, const uint8_t *in,
+                             uint32_t len, RLE_Span *result) {
+  if (context == NULL || in == NULL || len == 0 || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t bound = rleEncodeBound(len);
+  if (bound > UINT32_MAX ||
+      RLE_context_reserve(context, (uint32_t)bound) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  uint32_t size;
+  RLE_State state =
+      RLE_encode_into(in, len, context->buffer, context->capacity, &size);
+  if (state != RLE_OK) {
+    return state;
+  }
+
+  result->data = context->buffer;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_context_decode(RLE_Context *context, const uint8_t *in,
+                             uint32_t len, RLE_Span *result) {
+  if (context == NULL || in == NULL || len == 0 || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t limit = rleDecodeLimit(len, &context->options);
+  uint32_t size;
+  RLE_State state = RLE_ERROR_LIMIT;
+
+  // The buffer is mostly large enough, then the data are validated while
+  // they are decoded. Otherwise the decoded size is scanned to grow the
+  // buffer and the data are decoded again.
+  if (context->capacity > 0) {
+    uint32_t room =
+        context->capacity < limit ? context->capacity : (uint32_t)limit;
+    state = rleDecodeChecked(in, len, context->buffer, room, &size);
+  }
+  if (state == RLE_ERROR_LIMIT && context->capacity < limit) {
+    uint64_t total;
+    state = rleScanDecodedSize(in, len, limit, &total);
+    if (state == RLE_OK) {
+      state = RLE_context_reserve(context, (uint32_t)total);
+    }
+    if (state == RLE_OK) {
+      state = rleDecodeChecked(in, len, context->buffer, (uint32_t)total,
+                               &size);
+    }
+  }
+  if (state != RLE_OK) {
+    return state;
+  }
+
+  result->data = context->buffer;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+void RLE_context_free(RLE_Context *context) {
+  if (context != NULL) {
+    free(context->buffer);
+    context->buffer = NULL;
+    context->capacity = 0;
+  }
+}
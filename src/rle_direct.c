@@ -0,0 +1,360 @@
+/*!
+ * \file    rle_direct.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of RLE decoding to files bypassing the page cache.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE  // O_DIRECT
+
+#include "rle_direct.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! State shared by the decoder and the writer thread. */
+typedef struct {
+  int fd;               /*!< Output file descriptor. */
+  bool direct;          /*!< True while O_DIRECT is set on \a fd. */
+  bool bypassed;        /*!< False if the file system rejected O_DIRECT. */
+  uint64_t offset;      /*!< Offset of the next write. */
+  const uint8_t *data;  /*!< Buffer queued for writing, NULL if idle. */
+  uint32_t size;        /*!< Size of the queued buffer. */
+  bool stop;            /*!< True if no more buffers will be queued. */
+  bool failed;          /*!< True if any write failed. */
+  pthread_mutex_t lock; /*!< Lock of the queue fields. */
+  pthread_cond_t cond;  /*!< Signals a change of the queue fields. */
+} Writer;
+
+/*! Position in validated tokens, which may stop inside a token. */
+typedef struct {
+  const uint8_t *in; /*!< Encoded tokens. */
+  uint32_t len;      /*!< Length of encoded tokens. */
+  uint32_t pos;      /*!< Position of the next token. */
+  RleToken token;    /*!< Current token. */
+  uint32_t done;     /*!< Number of decoded bytes of the current token. */
+} TokenCursor;
+
+/* Private macros ------------------------------------------------------------*/
+#ifndef O_DIRECT
+#define O_DIRECT (0)  // not supported, buffered writes only
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static uint32_t fillBuffer(TokenCursor *cursor, uint8_t *out,
+                           uint32_t capacity);
+static int openOutput(const char *path, bool *direct);
+static void *writerThread(void *arg);
+static bool writeBuffer(Writer *writer, const uint8_t *data, uint32_t size);
+static bool writeAt(Writer *writer, const uint8_t *data, uint32_t size);
+static void clearDirect(Writer *writer);
+static bool queueBuffer(Writer *writer, const uint8_t *data, uint32_t size);
+static bool stopWriter(Writer *writer);
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_decode_direct(const uint8_t *in, uint32_t len, const char *path,
+                            uint64_t *written, bool *direct) {
+  if (in == NULL || len == 0 || path == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t size;
+  if (rleScanDecodedSize(in, len, UINT64_MAX, &size) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  void *buffers;
+  if (posix_memalign(&buffers, RLE_DIRECT_ALIGNMENT,
+                     2 * RLE_DIRECT_BUFFER_SIZE) != 0) {
+    return RLE_ERROR;
+  }
+
+  Writer writer;
+  writer.fd = openOutput(path, &writer.direct);
+  if (writer.fd < 0) {
+    free(buffers);
+    return RLE_ERROR;
+  }
+  writer.bypassed = writer.direct;
+  writer.offset = 0;
+  writer.data = NULL;
+  writer.stop = false;
+  writer.failed = false;
+
+  pthread_t thread;
+  pthread_mutex_init(&writer.lock, NULL);
+  pthread_cond_init(&writer.cond, NULL);
+  bool started = pthread_create(&thread, NULL, writerThread, &writer) == 0;
+  bool ok = started;
+
+  // The decoder fills one buffer while the writer writes the other one.
+  // Validated input is decoded without errors.
+  TokenCursor cursor = {in, len, 0, {NULL, 0, false}, 0};
+  uint32_t produced = RLE_DIRECT_BUFFER_SIZE;
+  int current = 0;
+
+  while (ok && produced == RLE_DIRECT_BUFFER_SIZE) {
+    uint8_t *buffer = (uint8_t *)buffers + current * RLE_DIRECT_BUFFER_SIZE;
+    produced = fillBuffer(&cursor, buffer, RLE_DIRECT_BUFFER_SIZE);
+    if (produced > 0) {
+      ok = queueBuffer(&writer, buffer, produced);
+    }
+    current ^= 1;
+  }
+
+  if (started) {
+    ok = stopWriter(&writer) && ok;
+    pthread_join(thread, NULL);
+  }
+  ok = close(writer.fd) == 0 && ok;
+
+  pthread_cond_destroy(&writer.cond);
+  pthread_mutex_destroy(&writer.lock);
+  free(buffers);
+
+  if (!ok) {
+    unlink(path);
+    return RLE_ERROR;
+  }
+
+  if (written != NULL) {
+    *written = writer.offset;
+  }
+  if (direct != NULL) {
+    *direct = writer.bypassed;
+  }
+
+  return RLE_OK;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Decodes validated tokens from the \a cursor until the \a out buffer is
+ * full or the tokens end. Runs are filled by words and literals copied, a
+ * token crossing the end of buffer is continued by the next call.
+ *
+ * \param[in,out] cursor    Position in the tokens.
+ * \param[out]    out       Output buffer.
+ * \param[in]     capacity  Size of output buffer.
+ *
+ * \return Number of decoded bytes, lower than \a capacity at the end.
+ */
+static uint32_t fillBuffer(TokenCursor *cursor, uint8_t *out,
+                           uint32_t capacity) {
+  RleToken *token = &cursor->token;
+  uint32_t produced = 0;
+
+  while (produced < capacity) {
+    if (cursor->done == token->count) {
+      if (cursor->pos == cursor->len) {
+        break;
+      }
+      rleReadToken(cursor->in, cursor->len, &cursor->pos, token);
+      cursor->done = 0;
+    }
+
+    uint32_t room = capacity - produced;
+    uint32_t left = token->count - cursor->done;
+    uint32_t n = left < room ? left : room;
+    if (token->literal) {
+      const uint8_t *data = &token->data[cursor->done];
+      uint32_t avail = (uint32_t)(&cursor->in[cursor->len] - data);
+      rleCopyLiteral(&out[produced], room, data, avail, n);
+    } else {
+      rleFillRun(&out[produced], room, token->data[0], n);
+    }
+    cursor->done += n;
+    produced += n;
+  }
+
+  return produced;
+}
+
+/*! Creates or truncates the output file, preferably with O_DIRECT.
+ *
+ * \param[in]   path    Path to the output file.
+ * \param[out]  direct  True if O_DIRECT is set.
+ *
+ * \return File descriptor, negative value on error.
+ */
+static int openOutput(const char *path, bool *direct) {
+  int flags = O_WRONLY | O_CREAT | O_TRUNC;
+  int fd = -1;
+
+  *direct = O_DIRECT != 0;
+  if (*direct) {
+    fd = open(path, flags | O_DIRECT, 0666);
+  }
+  if (fd < 0) {
+    *direct = false;
+    fd = open(path, flags, 0666);
+  }
+
+  return fd;
+}
+
+/*! Writes the queued buffers until \ref stopWriter is called.
+ *
+ * \param[in,out] arg     Writer state.
+ *
+ * \return Returns NULL.
+ */
+static void *writerThread(void *arg) {
+  Writer *writer = arg;
+
+  pthread_mutex_lock(&writer->lock);
+  for (;;) {
+    while (writer->data == NULL && !writer->stop) {
+      pthread_cond_wait(&writer->cond, &writer->lock);
+    }
+    if (writer->data == NULL) {
+      break;
+    }
+
+    const uint8_t *data = writer->data;
+    uint32_t size = writer->size;
+    pthread_mutex_unlock(&writer->lock);
+    bool ok = writeBuffer(writer, data, size);
+    pthread_mutex_lock(&writer->lock);
+
+    writer->failed = writer->failed || !ok;
+    writer->data = NULL;
+    pthread_cond_signal(&writer->cond);
+  }
+  pthread_mutex_unlock(&writer->lock);
+
+  return NULL;
+}
+
+/*! Writes one buffer. Only the last buffer may have a size, which is not
+ * multiple of the alignment, its tail is written without O_DIRECT.
+ *
+ * \param[in,out] writer  Writer state.
+ * \param[in]     data    Aligned buffer.
+ * \param[in]     size    Size of the buffer.
+ *
+ * \return Returns false if the data were not written.
+ */
+static bool writeBuffer(Writer *writer, const uint8_t *data, uint32_t size) {
+  uint32_t aligned = size;
+  if (writer->direct) {
+    aligned = size - size % RLE_DIRECT_ALIGNMENT;
+  }
+
+  if (!writeAt(writer, data, aligned)) {
+    return false;
+  }
+  if (aligned < size) {
+    clearDirect(writer);
+    return writeAt(writer, &data[aligned], size - aligned);
+  }
+
+  return true;
+}
+
+/*! Writes \a size bytes at the current offset, repeating the call after short
+ * writes and interrupts. If the file system rejects O_DIRECT, it is cleared
+ * and the write is repeated. A write of no bytes is an error, it would be
+ * repeated forever.
+ *
+ * \param[in,out] writer  Writer state.
+ * \param[in]     data    Written data.
+ * \param[in]     size    Size of data.
+ *
+ * \return Returns false if the data were not written.
+ */
+static bool writeAt(Writer *writer, const uint8_t *data, uint32_t size) {
+  uint32_t done = 0;
+
+  while (done < size) {
+    ssize_t n = pwrite(writer->fd, &data[done], size - done,
+                       (off_t)(writer->offset + done));
+    if (n < 0) {
+      if (errno == EINVAL && writer->direct) {
+        writer->bypassed = false;
+        clearDirect(writer);
+      } else if (errno != EINTR) {
+        return false;
+      }
+      continue;
+    }
+    if (n == 0) {
+      return false;
+    }
+    done += (uint32_t)n;
+  }
+  writer->offset += size;
+
+  return true;
+}
+
+/*! Clears O_DIRECT, the following writes go through the page cache.
+ *
+ * \param[in,out] writer  Writer state.
+ */
+static void clearDirect(Writer *writer) {
+  int flags = fcntl(writer->fd, F_GETFL);
+
+  if (flags >= 0) {
+    fcntl(writer->fd, F_SETFL, flags & ~O_DIRECT);
+  }
+  writer->direct = false;
+}
+
+/*! Waits until the previous buffer is written and queues the next one.
+ *
+ * \param[in,out] writer  Writer state.
+ * \param[in]     data    Buffer to write.
+ * \param[in]     size    Size of the buffer.
+ *
+ * \return Returns false if any previous write failed.
+ */
+static bool queueBuffer(Writer *writer, const uint8_t *data, uint32_t size) {
+  pthread_mutex_lock(&writer->lock);
+  while (writer->data != NULL) {
+    pthread_cond_wait(&writer->cond, &writer->lock);
+  }
+
+  bool ok = !writer->failed;
+  if (ok) {
+    writer->data = data;
+    writer->size = size;
+    pthread_cond_signal(&writer->cond);
+  }
+  pthread_mutex_unlock(&writer->lock);
+
+  return ok;
+}
+
+/*! Waits until the queued buffer is written and stops the writer thread.
+ *
+ * \param[in,out] writer  Writer state.
+ *
+ * \return Returns false if any write failed.
+ */
+static bool stopWriter(Writer *writer) {
+  pthread_mutex_lock(&writer->lock);
+  while (writer->data != NULL) {
+    pthread_cond_wait(&writer->cond, &writer->lock);
+  }
+
+  bool ok = !writer->failed;
+  writer->stop = true;
+  pthread_cond_signal(&writer->cond);
+  pthread_mutex_unlock(&writer->lock);
+
+  return ok;
+}
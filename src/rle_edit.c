@@ -0,0 +1,409 @@
+/*!
+ * \file    rle_edit.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of editing operations on RLE encoded data.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_edit.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! Tokens of encoded data affected by a patch. */
+typedef struct {
+  uint32_t start;       /*!< Position of the first affected token. */
+  uint32_t end;         /*!< Position behind the last affected token. */
+  uint32_t lastStart;   /*!< Position of the last affected token. */
+  uint64_t startOffset; /*!< Decoded offset of the first affected token. */
+  uint64_t endOffset;   /*!< Decoded offset behind the last affected token. */
+  uint64_t walked;      /*!< Decoded size of the walked tokens. */
+} PatchRegion;
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static RLE_State findLastToken(const uint8_t *in, uint32_t len,
+                               uint32_t *start);
+static RLE_State checkLastToken(const uint8_t *in, uint32_t len,
+                                uint32_t *start);
+static RLE_State findPatchRegion(const uint8_t *in, uint32_t len,
+                                 uint64_t first, uint64_t last,
+                                 PatchRegion *region);
+static void decodeToken(const RleToken *token, uint32_t skip, uint32_t n,
+                        uint8_t *out);
+static RLE_State encodeSeam(const uint8_t *first, uint32_t firstLen,
+                            uint32_t lastStart, const uint8_t *second,
+                            uint32_t secondLen, uint32_t *secondStart,
+                            uint8_t **seam, uint32_t *seamLen,
+                            uint32_t *joinedLast);
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_concat(const uint8_t *first, uint32_t firstLen,
+                     const uint8_t *second, uint32_t secondLen,
+                     RLE_Data *result) {
+  uint32_t last = RLE_EDIT_LAST_UNKNOWN;
+  return RLE_concat_ex(first, firstLen, second, secondLen, result, &last);
+}
+
+RLE_State RLE_concat_ex(const uint8_t *first, uint32_t firstLen,
+                        const uint8_t *second, uint32_t secondLen,
+                        RLE_Data *result, uint32_t *last) {
+  if ((first == NULL && firstLen != 0) || second == NULL || secondLen == 0 ||
+      result == NULL || last == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t lastStart = *last;
+  uint32_t secondStart;
+  uint8_t *seam;
+  uint32_t seamLen;
+  uint32_t joinedLast;
+
+  if (checkLastToken(first, firstLen, &lastStart) != RLE_OK ||
+      encodeSeam(first, firstLen, lastStart, second, secondLen, &secondStart,
+                 &seam, &seamLen, &joinedLast) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  uint64_t size = (uint64_t)lastStart + seamLen + (secondLen - secondStart);
+  uint8_t *data = size <= UINT32_MAX ? malloc(size) : NULL;
+  if (data == NULL) {
+    free(seam);
+    return RLE_ERROR;
+  }
+
+  memcpy(data, first, lastStart);
+  memcpy(data + lastStart, seam, seamLen);
+  memcpy(data + lastStart + seamLen, second + secondStart,
+         secondLen - secondStart);
+  free(seam);
+
+  result->data = data;
+  result->size = (uint32_t)size;
+  *last = lastStart + joinedLast;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_append(RLE_Data *data, const uint8_t *in, uint32_t len) {
+  uint32_t last = RLE_EDIT_LAST_UNKNOWN;
+  return RLE_append_ex(data, in, len, &last);
+}
+
+RLE_State RLE_append_ex(RLE_Data *data, const uint8_t *in, uint32_t len,
+                        uint32_t *last) {
+  if (data == NULL || (data->data == NULL && data->size != 0) || in == NULL ||
+      len == 0 || last == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t lastStart = *last;
+  uint32_t inStart;
+  uint8_t *seam;
+  uint32_t seamLen;
+  uint32_t joinedLast;
+
+  if (checkLastToken(data->data, data->size, &lastStart) != RLE_OK ||
+      encodeSeam(data->data, data->size, lastStart, in, len, &inStart, &seam,
+                 &seamLen, &joinedLast) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  uint64_t size = (uint64_t)lastStart + seamLen + (len - inStart);
+  uint8_t *p = size <= UINT32_MAX ? realloc(data->data, size) : NULL;
+  if (p == NULL) {
+    free(seam);
+    return RLE_ERROR;
+  }
+
+  memcpy(p + lastStart, seam, seamLen);
+  memcpy(p + lastStart + seamLen, in + inStart, len - inStart);
+  free(seam);
+
+  data->data = p;
+  data->size = (uint32_t)size;
+  *last = lastStart + joinedLast;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_patch(RLE_Data *data, uint32_t offset, uint32_t length,
+                    const uint8_t *replacement, uint32_t replacementLen) {
+  if (data == NULL || (data->data == NULL && data->size != 0) ||
+      (replacement == NULL && replacementLen != 0)) {
+    return RLE_ERROR;
+  }
+
+  // the neighbouring bytes are included to merge runs around the range
+  uint64_t end = (uint64_t)offset + length;
+  PatchRegion region;
+  if (findPatchRegion(data->data, data->size, offset > 0 ? offset - 1 : 0, end,
+                      &region) != RLE_OK ||
+      end > region.walked) {
+    return RLE_ERROR;
+  }
+
+  // prefix lies in the first affected token and suffix in the last one
+  uint32_t prefixLen = (uint32_t)(offset - region.startOffset);
+  uint32_t suffixLen = (uint32_t)(region.endOffset - end);
+  uint64_t plainLen = (uint64_t)prefixLen + replacementLen + suffixLen;
+  uint64_t encodedBound = rleEncodeBound(plainLen);
+  uint64_t size = (uint64_t)data->size - (region.end - region.start);
+  if (size + encodedBound > UINT32_MAX) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *plain = malloc(plainLen + encodedBound);
+  if (plain == NULL) {
+    return RLE_ERROR;
+  }
+  uint8_t *encoded = plain + plainLen;
+
+  RleToken token;
+  if (prefixLen > 0) {
+    uint32_t pos = region.start;
+    rleReadToken(data->data, data->size, &pos, &token);
+    decodeToken(&token, 0, prefixLen, plain);
+  }
+  if (replacementLen > 0) {
+    memcpy(plain + prefixLen, replacement, replacementLen);
+  }
+  if (suffixLen > 0) {
+    uint32_t pos = region.lastStart;
+    rleReadToken(data->data, data->size, &pos, &token);
+    decodeToken(&token, token.count - suffixLen, suffixLen,
+                plain + prefixLen + replacementLen);
+  }
+
+  uint32_t consumed;
+  uint32_t encodedLen =
+      rleEncodeTokens(plain, (uint32_t)plainLen, encoded, true, &consumed);
+  uint32_t tailLen = data->size - region.end;
+  size += encodedLen;
+
+  uint8_t *p = data->data;
+  if (size > data->size) {
+    p = realloc(data->data, size);
+    if (p == NULL) {
+      free(plain);
+      return RLE_ERROR;
+    }
+  }
+
+  memmove(p + region.start + encodedLen, p + region.end, tailLen);
+  memcpy(p + region.start, encoded, encodedLen);
+  free(plain);
+
+  if (size == 0) {
+    free(p);
+    p = NULL;
+  } else if (size < data->size) {
+    uint8_t *shrunk = realloc(p, size);
+    p = shrunk != NULL ? shrunk : p;
+  }
+
+  data->data = p;
+  data->size = (uint32_t)size;
+
+  return RLE_OK;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Validates encoded data and finds the start of their last token.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  start   Position of the last token, \a len for empty input.
+ *
+ * \return \ref RLE_ERROR for malformed input, \ref RLE_OK otherwise.
+ */
+static RLE_State findLastToken(const uint8_t *in, uint32_t len,
+                               uint32_t *start) {
+  uint32_t i = 0;
+
+  *start = len;
+  while (i < len) {
+    RleToken token;
+    uint32_t tokenStart = i;
+
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+    *start = tokenStart;
+  }
+
+  return RLE_OK;
+}
+
+/*! Checks the position of the last token of encoded data known by the caller.
+ * Only the token at the position is validated, it must end the data. Unknown
+ * position is found by \ref findLastToken.
+ *
+ * \param[in]     in      Encoded input array.
+ * \param[in]     len     Length of input array.
+ * \param[in,out] start   Position of the last token, \a len for empty input,
+ * or \ref RLE_EDIT_LAST_UNKNOWN.
+ *
+ * \return \ref RLE_ERROR for malformed input or wrong position, \ref RLE_OK
+ * otherwise.
+ */
+static RLE_State checkLastToken(const uint8_t *in, uint32_t len,
+                                uint32_t *start) {
+  if (*start == RLE_EDIT_LAST_UNKNOWN) {
+    return findLastToken(in, len, start);
+  }
+  if (*start >= len) {
+    return *start == len && len == 0 ? RLE_OK : RLE_ERROR;
+  }
+
+  RleToken token;
+  uint32_t i = *start;
+  if (rleReadToken(in, len, &i, &token) != RLE_OK || i != len) {
+    return RLE_ERROR;
+  }
+
+  return RLE_OK;
+}
+
+/*! Finds the tokens, which contain any decoded byte from the range
+ * [\a first, \a last]. The walk stops at the first token behind the range,
+ * only the walked tokens are validated.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   first   Decoded offset of the first byte of the range.
+ * \param[in]   last    Decoded offset of the last byte of the range.
+ * \param[out]  region  Found tokens, empty region at the end of data if no
+ * token is found. The walked size exceeds \a last unless the walk reached
+ * the end of data.
+ *
+ * \return \ref RLE_ERROR for malformed input, \ref RLE_OK otherwise.
+ */
+static RLE_State findPatchRegion(const uint8_t *in, uint32_t len,
+                                 uint64_t first, uint64_t last,
+                                 PatchRegion *region) {
+  uint64_t offset = 0;
+  uint32_t i = 0;
+  bool found = false;
+
+  while (i < len && offset <= last) {
+    RleToken token;
+    uint32_t tokenStart = i;
+
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+
+    if (offset + token.count > first) {
+      if (!found) {
+        region->start = tokenStart;
+        region->startOffset = offset;
+        found = true;
+      }
+      region->lastStart = tokenStart;
+      region->end = i;
+      region->endOffset = offset + token.count;
+    }
+    offset += token.count;
+  }
+
+  if (!found) {
+    region->start = region->end = region->lastStart = len;
+    region->startOffset = region->endOffset = offset;
+  }
+  region->walked = offset;
+
+  return RLE_OK;
+}
+
+/*! Decodes \a n bytes of the \a token starting from its byte \a skip.
+ *
+ * \param[in]   token   Validated token.
+ * \param[in]   skip    Number of skipped decoded bytes.
+ * \param[in]   n       Number of decoded bytes.
+ * \param[out]  out     Output buffer for \a n bytes.
+ */
+static void decodeToken(const RleToken *token, uint32_t skip, uint32_t n,
+                        uint8_t *out) {
+  if (token->literal) {
+    memcpy(out, token->data + skip, n);
+  } else {
+    memset(out, token->data[0], n);
+  }
+}
+
+/*! Encodes the last token of \a first together with the first token of
+ * \a second. The tokens of \a second are validated by one walk, which also
+ * finds the last token of the joined data.
+ *
+ * \param[in]   first       First encoded array.
+ * \param[in]   firstLen    Length of the first array.
+ * \param[in]   lastStart   Position of the last token in the first array.
+ * \param[in]   second      Second encoded array.
+ * \param[in]   secondLen   Length of the second array.
+ * \param[out]  secondStart Position behind the first token of second array.
+ * \param[out]  seam        Encoded seam allocated on heap, the caller frees it.
+ * \param[out]  seamLen     Size of the encoded seam.
+ * \param[out]  joinedLast  Position of the last token of the joined data
+ * relative to \a lastStart.
+ *
+ * \return \ref RLE_ERROR for malformed \a second or allocation failure,
+ * \ref RLE_OK otherwise.
+ */
+static RLE_State encodeSeam(const uint8_t *first, uint32_t firstLen,
+                            uint32_t lastStart, const uint8_t *second,
+                            uint32_t secondLen, uint32_t *secondStart,
+                            uint8_t **seam, uint32_t *seamLen,
+                            uint32_t *joinedLast) {
+  uint32_t secondLast;
+  if (findLastToken(second, secondLen, &secondLast) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  // Stored blocks make the tokens too long for a stack buffer.
+  RleToken last = {NULL, 0, false};
+  RleToken next;
+  if (lastStart < firstLen) {
+    rleReadToken(first, firstLen, &lastStart, &last);
+  }
+  *secondStart = 0;
+  rleReadToken(second, secondLen, secondStart, &next);
+
+  uint32_t plainLen = last.count + next.count;
+  uint64_t bound = rleEncodeBound(plainLen);
+  uint8_t *out = malloc(bound + plainLen);
+  if (out == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *plain = out + bound;
+  if (last.count > 0) {
+    decodeToken(&last, 0, last.count, plain);
+  }
+  decodeToken(&next, 0, next.count, plain + last.count);
+
+  uint32_t consumed;
+  *seamLen = rleEncodeTokens(plain, plainLen, out, true, &consumed);
+  *seam = out;
+
+  // A single token of second array ends in the seam.
+  if (secondLast >= *secondStart) {
+    *joinedLast = *seamLen + (secondLast - *secondStart);
+  } else {
+    findLastToken(out, *seamLen, joinedLast);
+  }
+
+  return RLE_OK;
+}
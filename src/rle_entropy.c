@@ -0,0 +1,701 @@
+/*!
+ * \file    rle_entropy.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of entropy coded RLE.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_entropy.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! Entry of decoding table, it decodes one or two symbols. */
+typedef struct {
+  uint8_t symbols[2]; /*!< Decoded symbols. */
+  uint8_t firstBits;  /*!< Code length of the first symbol. */
+  uint8_t bits;       /*!< Code length of all decoded symbols. */
+  uint8_t count;      /*!< Number of decoded symbols, zero for invalid code. */
+} TableEntry;
+
+/*! Decoding tables of both symbol streams. */
+typedef struct {
+  TableEntry headers[1 << 11]; /*!< Table of header symbols. */
+  TableEntry values[1 << 11];  /*!< Table of value symbols. */
+} DecodeTables;
+
+/*! Writer of most significant bit first bitstream. */
+typedef struct {
+  uint8_t *out; /*!< Next output byte. */
+  uint64_t acc; /*!< Pending bits in the low part. */
+  uint32_t bits; /*!< Number of pending bits. */
+} BitWriter;
+
+/*! Reader of most significant bit first bitstream. */
+typedef struct {
+  const uint8_t *data; /*!< Bitstream. */
+  uint32_t size;       /*!< Size of bitstream in bytes. */
+  uint64_t pos;        /*!< Next loaded byte, may run behind the end. */
+  uint64_t acc;        /*!< Loaded bits in the high part. */
+  uint32_t bits;       /*!< Number of loaded bits. */
+} BitReader;
+
+/*! One symbol stream of encoded data. */
+typedef struct {
+  uint8_t lengths[256]; /*!< Code lengths. */
+  const uint8_t *data;  /*!< Bitstream. */
+  uint32_t size;        /*!< Size of bitstream. */
+} SymbolStream;
+
+/*! Symbols of one bitstream decoded ahead of their use. */
+typedef struct {
+  BitReader reader;         /*!< Reader of the bitstream. */
+  const TableEntry *table;  /*!< Decoding table of the bitstream. */
+  uint32_t left;            /*!< Number of symbols not decoded yet. */
+  uint32_t pos;             /*!< Next unused decoded symbol. */
+  uint32_t count;           /*!< Number of decoded symbols. */
+  RleLookupStats stats;     /*!< Statistics of table lookups. */
+  uint8_t symbols[64];      /*!< Decoded symbols. */
+} SymbolQueue;
+
+/* Private macros ------------------------------------------------------------*/
+/*! Maximal code length, also the number of bits indexing decoding table. */
+#define MAX_CODE_BITS (11)
+
+/*! Number of entries of decoding table. */
+#define TABLE_SIZE (1u << MAX_CODE_BITS)
+
+/*! Number of symbols of both streams. */
+#define SYMBOLS (256)
+
+/*! Size of stored code lengths, two lengths per byte. */
+#define LENGTHS_SIZE (SYMBOLS / 2)
+
+/*! Size of the header with decoded size and both symbol counts. */
+#define HEADER_SIZE (12)
+
+/*! Number of symbols decoded ahead of their use. */
+#define SYMBOL_BATCH (64)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static void writeU32(uint8_t *out, uint32_t value);
+static uint32_t readU32(const uint8_t *in);
+static uint8_t huffmanLengths(const uint32_t *weights, uint8_t *lengths);
+static void buildCodes(const uint8_t *lengths, uint16_t *codes);
+static bool buildTable(const uint8_t *lengths, TableEntry *table);
+static uint8_t *writeStream(uint8_t *out, const uint8_t *tokens, uint32_t len,
+                            bool values, const uint32_t *freq);
+static bool readStream(const uint8_t *in, uint32_t len, uint32_t *pos,
+                       SymbolStream *stream);
+static inline void writeBits(BitWriter *writer, uint32_t code,
+                             uint32_t length);
+static inline void refill(BitReader *reader);
+static uint32_t decodeSymbols(SymbolQueue *queue, uint8_t *out, uint32_t n);
+static inline bool takeSymbol(SymbolQueue *queue, uint8_t *symbol);
+static bool takeSymbols(SymbolQueue *queue, uint8_t *out, uint32_t n);
+static bool decodeTokens(const SymbolStream *headers,
+                         const SymbolStream *values,
+                         const DecodeTables *tables, uint32_t tokens,
+                         uint32_t symbols, uint8_t *out, uint32_t size,
+                         RleLookupStats *stats);
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_encode_entropy(const uint8_t *in, uint32_t len,
+                             RLE_Data *result) {
+  if (in == NULL || len == 0 || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t bound = rleEncodeBound(len);
+  if (bound > UINT32_MAX) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *tokens = malloc(bound);
+  if (tokens == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t consumed;
+  uint32_t size = rleEncodeTokens(in, len, tokens, true, &consumed);
+
+  uint32_t headerFreq[SYMBOLS] = {0};
+  uint32_t valueFreq[SYMBOLS] = {0};
+  uint32_t headerCount = 0;
+  uint32_t valueCount = 0;
+
+  for (uint32_t i = 0; i < size;) {
+    // The length of stored block is coded in the header stream.
+    RleToken token;
+    uint32_t start = i;
+    rleReadToken(tokens, size, &i, &token);
+    uint32_t n = token.literal ? token.count : 1;
+
+    for (const uint8_t *h = &tokens[start]; h < token.data; h++) {
+      headerFreq[*h]++;
+    }
+    headerCount++;
+    for (uint32_t k = 0; k < n; k++) {
+      valueFreq[token.data[k]]++;
+    }
+    valueCount += n;
+  }
+
+  uint64_t outBound = HEADER_SIZE + 2 * (LENGTHS_SIZE + 4) +
+                      ((uint64_t)headerCount * STORED_HEADER_SIZE *
+                           MAX_CODE_BITS + 7) / 8 +
+                      ((uint64_t)valueCount * MAX_CODE_BITS + 7) / 8;
+  uint8_t *data = outBound <= UINT32_MAX ? malloc(outBound) : NULL;
+  if (data == NULL) {
+    free(tokens);
+    return RLE_ERROR;
+  }
+
+  writeU32(&data[0], len);
+  writeU32(&data[4], headerCount);
+  writeU32(&data[8], valueCount);
+
+  uint8_t *end = writeStream(&data[HEADER_SIZE], tokens, size, false,
+                             headerFreq);
+  end = writeStream(end, tokens, size, true, valueFreq);
+  free(tokens);
+
+  uint32_t outSize = (uint32_t)(end - data);
+  uint8_t *p = realloc(data, outSize);
+
+  result->data = p != NULL ? p : data;
+  result->size = outSize;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_decode_entropy(const uint8_t *in, uint32_t len,
+                             RLE_Data *result) {
+  return rleDecodeEntropy(in, len, result, NULL);
+}
+
+/* Internal functions definitions --------------------------------------------*/
+RLE_State rleDecodeEntropy(const uint8_t *in, uint32_t len, RLE_Data *result,
+                           RleLookupStats *stats) {
+  if (in == NULL || len < HEADER_SIZE || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t size = readU32(&in[0]);
+  uint32_t headerCount = readU32(&in[4]);
+  uint32_t valueCount = readU32(&in[8]);
+  uint32_t pos = HEADER_SIZE;
+  SymbolStream headers;
+  SymbolStream values;
+
+  // Every code takes at least one bit, every run at most 127 bytes and every
+  // literal byte a value code, so the allocated size is bounded by the input
+  // size.
+  if (!readStream(in, len, &pos, &headers) ||
+      !readStream(in, len, &pos, &values) || pos != len || size == 0 ||
+      headerCount > (uint64_t)headers.size * 8 ||
+      valueCount > (uint64_t)values.size * 8 ||
+      size > (uint64_t)headerCount * MAX_COUNT + valueCount) {
+    return RLE_ERROR;
+  }
+
+  DecodeTables *tables = malloc(sizeof(DecodeTables));
+  if (tables == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data = NULL;
+  bool valid = buildTable(headers.lengths, tables->headers) &&
+               buildTable(values.lengths, tables->values) &&
+               (data = malloc(size)) != NULL &&
+               decodeTokens(&headers, &values, tables, headerCount,
+                            valueCount, data, size, stats);
+  free(tables);
+
+  if (!valid) {
+    free(data);
+    return RLE_ERROR;
+  }
+
+  result->data = data;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+/*! Computes Huffman code lengths limited to \ref MAX_CODE_BITS. While the
+ * limit is exceeded, the frequencies are halved, which flattens the tree.
+ *
+ * \param[in]   freq      Symbol frequencies.
+ * \param[out]  lengths   Code lengths, zero for unused symbols.
+ */
+void rleHuffmanLengths(const uint32_t *freq, uint8_t *lengths) {
+  uint32_t weights[SYMBOLS];
+  memcpy(weights, freq, sizeof(weights));
+
+  while (huffmanLengths(weights, lengths) > MAX_CODE_BITS) {
+    for (uint32_t s = 0; s < SYMBOLS; s++) {
+      weights[s] = weights[s] - weights[s] / 2;
+    }
+  }
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Stores 32 bit little endian integer.
+ *
+ * \param[out]  out     Output bytes.
+ * \param[in]   value   Stored value.
+ */
+static void writeU32(uint8_t *out, uint32_t value) {
+  for (int b = 0; b < 4; b++) {
+    out[b] = (uint8_t)(value >> (8 * b));
+  }
+}
+
+/*! Loads 32 bit little endian integer.
+ *
+ * \param[in]   in      Input bytes.
+ *
+ * \return Loaded value.
+ */
+static uint32_t readU32(const uint8_t *in) {
+  uint32_t value = 0;
+  for (int b = 0; b < 4; b++) {
+    value |= (uint32_t)in[b] << (8 * b);
+  }
+
+  return value;
+}
+
+/*! Computes Huffman code lengths for symbols with non-zero \a weights. The
+ * tree is built by the two queue method over the leaves sorted by weight.
+ *
+ * \param[in]   weights   Symbol weights.
+ * \param[out]  lengths   Code lengths, zero for unused symbols.
+ *
+ * \return Maximal code length.
+ */
+static uint8_t huffmanLengths(const uint32_t *weights, uint8_t *lengths) {
+  uint16_t order[SYMBOLS];
+  uint64_t weight[2 * SYMBOLS];
+  uint16_t parent[2 * SYMBOLS];
+  uint8_t depth[2 * SYMBOLS];
+  uint32_t n = 0;
+
+  for (uint32_t s = 0; s < SYMBOLS; s++) {
+    lengths[s] = 0;
+    if (weights[s] != 0) {
+      // Insertion sort, the alphabet is small.
+      uint32_t k = n++;
+      while (k > 0 && weights[order[k - 1]] > weights[s]) {
+        order[k] = order[k - 1];
+        k--;
+      }
+      order[k] = (uint16_t)s;
+    }
+  }
+
+  if (n <= 1) {
+    if (n == 1) {
+      lengths[order[0]] = 1;
+    }
+    return (uint8_t)n;
+  }
+
+  for (uint32_t k = 0; k < n; k++) {
+    weight[k] = weights[order[k]];
+  }
+
+  uint32_t leaf = 0;
+  uint32_t inner = n;
+  for (uint32_t next = n; next < 2 * n - 1; next++) {
+    uint32_t pair[2];
+    for (int p = 0; p < 2; p++) {
+      if (leaf < n && (inner == next || weight[leaf] <= weight[inner])) {
+        pair[p] = leaf++;
+      } else {
+        pair[p] = inner++;
+      }
+    }
+    weight[next] = weight[pair[0]] + weight[pair[1]];
+    parent[pair[0]] = (uint16_t)next;
+    parent[pair[1]] = (uint16_t)next;
+  }
+
+  uint8_t maxLength = 0;
+  depth[2 * n - 2] = 0;
+  for (uint32_t node = 2 * n - 2; node-- > 0;) {
+    depth[node] = depth[parent[node]] + 1;
+    if (node < n) {
+      lengths[order[node]] = depth[node];
+      if (depth[node] > maxLength) {
+        maxLength = depth[node];
+      }
+    }
+  }
+
+  return maxLength;
+}
+
+/*! Assigns canonical codes to the symbols with given code \a lengths.
+ *
+ * \param[in]   lengths   Code lengths, zero for unused symbols.
+ * \param[out]  codes     Codes, aligned to the least significant bit.
+ */
+static void buildCodes(const uint8_t *lengths, uint16_t *codes) {
+  uint16_t count[MAX_CODE_BITS + 1] = {0};
+  uint16_t next[MAX_CODE_BITS + 1];
+  uint16_t code = 0;
+
+  for (uint32_t s = 0; s < SYMBOLS; s++) {
+    count[lengths[s]]++;
+  }
+  count[0] = 0;
+
+  for (uint32_t bits = 1; bits <= MAX_CODE_BITS; bits++) {
+    code = (uint16_t)((code + count[bits - 1]) << 1);
+    next[bits] = code;
+  }
+
+  for (uint32_t s = 0; s < SYMBOLS; s++) {
+    if (lengths[s] != 0) {
+      codes[s] = next[lengths[s]]++;
+    }
+  }
+}
+
+/*! Builds the decoding table for canonical codes with given code \a lengths.
+ * Each entry decodes the symbol, whose code prefixes the index, and the
+ * following symbol too if its code fits to the rest of index bits.
+ *
+ * \param[in]   lengths   Code lengths, zero for unused symbols.
+ * \param[out]  table     Decoding table of \ref TABLE_SIZE entries.
+ *
+ * \return Returns false if the lengths do not form a prefix code.
+ */
+static bool buildTable(const uint8_t *lengths, TableEntry *table) {
+  uint16_t codes[SYMBOLS];
+  uint32_t kraft = 0;
+
+  for (uint32_t s = 0; s < SYMBOLS; s++) {
+    if (lengths[s] != 0) {
+      kraft += TABLE_SIZE >> lengths[s];
+    }
+  }
+  if (kraft > TABLE_SIZE) {
+    return false;
+  }
+
+  buildCodes(lengths, codes);
+  memset(table, 0, TABLE_SIZE * sizeof(TableEntry));
+
+  for (uint32_t s = 0; s < SYMBOLS; s++) {
+    if (lengths[s] != 0) {
+      uint32_t shift = MAX_CODE_BITS - lengths[s];
+      uint32_t start = (uint32_t)codes[s] << shift;
+      for (uint32_t k = 0; k < (1u << shift); k++) {
+        TableEntry *entry = &table[start + k];
+        entry->symbols[0] = (uint8_t)s;
+        entry->firstBits = lengths[s];
+        entry->bits = lengths[s];
+        entry->count = 1;
+      }
+    }
+  }
+
+  // The first symbol and its length of any entry are final, so the entries
+  // may be paired in place.
+  for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+    TableEntry *entry = &table[i];
+    if (entry->count == 1 && entry->firstBits < MAX_CODE_BITS) {
+      const TableEntry *second =
+          &table[(i << entry->firstBits) & (TABLE_SIZE - 1)];
+      if (second->count != 0 &&
+          second->firstBits <= MAX_CODE_BITS - entry->firstBits) {
+        entry->symbols[1] = second->symbols[0];
+        entry->bits = entry->firstBits + second->firstBits;
+        entry->count = 2;
+      }
+    }
+  }
+
+  return true;
+}
+
+/*! Writes code lengths, bitstream size and bitstream of one symbol stream.
+ *
+ * \param[out]  out       Output buffer.
+ * \param[in]   tokens    Encoded tokens.
+ * \param[in]   len       Length of encoded tokens.
+ * \param[in]   values    True for value stream, false for header stream.
+ * \param[in]   freq      Symbol frequencies of the stream.
+ *
+ * \return Pointer behind the written stream.
+ */
+static uint8_t *writeStream(uint8_t *out, const uint8_t *tokens, uint32_t len,
+                            bool values, const uint32_t *freq) {
+  uint8_t lengths[SYMBOLS];
+  uint16_t codes[SYMBOLS];
+
+  rleHuffmanLengths(freq, lengths);
+  buildCodes(lengths, codes);
+
+  for (uint32_t k = 0; k < LENGTHS_SIZE; k++) {
+    out[k] = (uint8_t)(lengths[2 * k] | (lengths[2 * k + 1] << 4));
+  }
+
+  uint8_t *size = &out[LENGTHS_SIZE];
+  BitWriter writer = {&size[4], 0, 0};
+
+  for (uint32_t i = 0; i < len;) {
+    RleToken token;
+    uint32_t start = i;
+    rleReadToken(tokens, len, &i, &token);
+
+    const uint8_t *symbol = values ? token.data : &tokens[start];
+    const uint8_t *end = values ? &tokens[i] : token.data;
+    for (; symbol < end; symbol++) {
+      writeBits(&writer, codes[*symbol], lengths[*symbol]);
+    }
+  }
+
+  if (writer.bits > 0) {
+    *writer.out++ = (uint8_t)(writer.acc << (8 - writer.bits));
+  }
+
+  writeU32(size, (uint32_t)(writer.out - &size[4]));
+  return writer.out;
+}
+
+/*! Reads code lengths and locates the bitstream of one symbol stream.
+ *
+ * \param[in]     in        Encoded input array.
+ * \param[in]     len       Length of input array.
+ * \param[in,out] pos       Position of the stream, moved behind it.
+ * \param[out]    stream    Read stream.
+ *
+ * \return Returns false if the stream is truncated or a length is too big.
+ */
+static bool readStream(const uint8_t *in, uint32_t len, uint32_t *pos,
+                       SymbolStream *stream) {
+  if (len - *pos < LENGTHS_SIZE + 4) {
+    return false;
+  }
+
+  for (uint32_t k = 0; k < LENGTHS_SIZE; k++) {
+    stream->lengths[2 * k] = in[*pos + k] & 0x0f;
+    stream->lengths[2 * k + 1] = in[*pos + k] >> 4;
+    if (stream->lengths[2 * k] > MAX_CODE_BITS ||
+        stream->lengths[2 * k + 1] > MAX_CODE_BITS) {
+      return false;
+    }
+  }
+  *pos += LENGTHS_SIZE;
+
+  stream->size = readU32(&in[*pos]);
+  *pos += 4;
+  if (stream->size > len - *pos) {
+    return false;
+  }
+
+  stream->data = &in[*pos];
+  *pos += stream->size;
+
+  return true;
+}
+
+/*! Appends \a length bits of \a code to the bitstream.
+ *
+ * \param[in,out] writer    Bitstream writer.
+ * \param[in]     code      Code aligned to the least significant bit.
+ * \param[in]     length    Code length.
+ */
+static inline void writeBits(BitWriter *writer, uint32_t code,
+                             uint32_t length) {
+  writer->acc = (writer->acc << length) | code;
+  writer->bits += length;
+  while (writer->bits >= 8) {
+    writer->bits -= 8;
+    *writer->out++ = (uint8_t)(writer->acc >> writer->bits);
+  }
+}
+
+/*! Loads whole bytes until at least 57 bits are available. Zeros are loaded
+ * behind the end of bitstream, the overrun is checked after decoding.
+ *
+ * \param[in,out] reader    Bitstream reader.
+ */
+static inline void refill(BitReader *reader) {
+  while (reader->bits <= 56) {
+    uint8_t byte = reader->pos < reader->size ? reader->data[reader->pos] : 0;
+    reader->acc |= (uint64_t)byte << (56 - reader->bits);
+    reader->bits += 8;
+    reader->pos++;
+  }
+}
+
+/*! Decodes up to \a n symbols to the \a out buffer, two symbols per table
+ * lookup where possible. The decoding stops before an invalid code or a code
+ * running behind the end of bitstream, so the symbols may be decoded ahead
+ * of their use.
+ *
+ * \param[in,out] queue     Queue of the bitstream.
+ * \param[out]    out       Output buffer.
+ * \param[in]     n         Maximal number of decoded symbols.
+ *
+ * \return Number of decoded symbols.
+ */
+static uint32_t decodeSymbols(SymbolQueue *queue, uint8_t *out, uint32_t n) {
+  BitReader *reader = &queue->reader;
+  const TableEntry *table = queue->table;
+  uint32_t done = 0;
+
+  n = n < queue->left ? n : queue->left;
+  while (done < n) {
+    refill(reader);
+    uint64_t avail =
+        (uint64_t)reader->size * 8 - (reader->pos * 8 - reader->bits);
+
+    while (done < n && reader->bits >= MAX_CODE_BITS) {
+      const TableEntry *entry = &table[reader->acc >> (64 - MAX_CODE_BITS)];
+      uint32_t bits = entry->firstBits;
+
+      if (entry->count == 0 || bits > avail) {
+        queue->left -= done;
+        return done;
+      }
+
+      queue->stats.lookups++;
+      out[done++] = entry->symbols[0];
+      if (entry->count == 2 && done < n && entry->bits <= avail) {
+        out[done++] = entry->symbols[1];
+        bits = entry->bits;
+        queue->stats.pairs++;
+      }
+
+      reader->acc <<= bits;
+      reader->bits -= bits;
+      avail -= bits;
+    }
+  }
+
+  queue->left -= done;
+  return done;
+}
+
+/*! Takes the next symbol of the \a queue, a batch of symbols is decoded if
+ * the queue is empty.
+ *
+ * \param[in,out] queue     Queue of the bitstream.
+ * \param[out]    symbol    Taken symbol.
+ *
+ * \return Returns false if no symbol can be decoded.
+ */
+static inline bool takeSymbol(SymbolQueue *queue, uint8_t *symbol) {
+  if (queue->pos == queue->count) {
+    queue->pos = 0;
+    queue->count = decodeSymbols(queue, queue->symbols, SYMBOL_BATCH);
+    if (queue->count == 0) {
+      return false;
+    }
+  }
+
+  *symbol = queue->symbols[queue->pos++];
+  return true;
+}
+
+/*! Takes the next \a n symbols of the \a queue. The symbols, which are not
+ * decoded yet, are decoded directly to the \a out buffer.
+ *
+ * \param[in,out] queue     Queue of the bitstream.
+ * \param[out]    out       Output buffer.
+ * \param[in]     n         Number of taken symbols.
+ *
+ * \return Returns false if the symbols can not be decoded.
+ */
+static bool takeSymbols(SymbolQueue *queue, uint8_t *out, uint32_t n) {
+  uint32_t buffered = queue->count - queue->pos;
+
+  if (buffered >= n) {
+    memcpy(out, &queue->symbols[queue->pos], n);
+    queue->pos += n;
+    return true;
+  }
+
+  memcpy(out, &queue->symbols[queue->pos], buffered);
+  queue->pos = queue->count;
+  n -= buffered;
+
+  return decodeSymbols(queue, &out[buffered], n) == n;
+}
+
+/*! Decodes the tokens from both symbol streams to the \a out buffer. Both
+ * streams are decoded ahead in batches, so the table entries with two
+ * symbols serve the interleaved headers and run values too.
+ *
+ * \param[in]   headers   Header stream.
+ * \param[in]   values    Value stream.
+ * \param[in]   tables    Decoding tables of both streams.
+ * \param[in]   tokens    Number of tokens.
+ * \param[in]   symbols   Number of value symbols.
+ * \param[out]  out       Output buffer.
+ * \param[in]   size      Size of decoded data.
+ * \param[out]  stats     Statistics of table lookups, may be NULL.
+ *
+ * \return Returns false if the streams are malformed.
+ */
+static bool decodeTokens(const SymbolStream *headers,
+                         const SymbolStream *values,
+                         const DecodeTables *tables, uint32_t tokens,
+                         uint32_t symbols, uint8_t *out, uint32_t size,
+                         RleLookupStats *stats) {
+  SymbolQueue headerQueue = {{headers->data, headers->size, 0, 0, 0},
+                             tables->headers, UINT32_MAX, 0, 0, {0, 0}, {0}};
+  SymbolQueue valueQueue = {{values->data, values->size, 0, 0, 0},
+                            tables->values, symbols, 0, 0, {0, 0}, {0}};
+  uint32_t produced = 0;
+  bool valid = true;
+
+  for (uint32_t t = 0; t < tokens && valid; t++) {
+    uint8_t header = 0;
+    uint8_t length[2] = {0, 0};
+    valid = takeSymbol(&headerQueue, &header) &&
+            (header != STORED_HEADER ||
+             (takeSymbol(&headerQueue, &length[0]) &&
+              takeSymbol(&headerQueue, &length[1])));
+
+    uint32_t count = header == STORED_HEADER
+                         ? length[0] | (uint32_t)length[1] << 8
+                         : header & MAX_COUNT;
+    if (!valid || count == 0 || count > size - produced) {
+      valid = false;
+    } else if (header & LITERAL_FLAG) {
+      valid = takeSymbols(&valueQueue, &out[produced], count);
+    } else {
+      uint8_t value = 0;
+      valid = takeSymbol(&valueQueue, &value);
+      memset(&out[produced], value, count);
+    }
+    produced += count;
+  }
+
+  if (stats != NULL) {
+    stats->lookups = headerQueue.stats.lookups + valueQueue.stats.lookups;
+    stats->pairs = headerQueue.stats.pairs + valueQueue.stats.pairs;
+  }
+
+  return valid && produced == size && valueQueue.left == 0 &&
+         valueQueue.pos == valueQueue.count;
+}
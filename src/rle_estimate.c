@@ -0,0 +1,388 @@
+/*!
+ * \file    rle_estimate.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of RLE compressibility estimation.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_estimate.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "rle_hybrid.h"
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! Sums of window costs of one mode. */
+typedef struct {
+  double cost;   /*!< Sum of window costs in bytes. */
+  double ratio;  /*!< Sum of cost to window size ratios. */
+  double ratio2; /*!< Sum of squared ratios. */
+} CostSums;
+
+/* Private macros ------------------------------------------------------------*/
+/*! Default size of sampled window. */
+#define DEFAULT_WINDOW_SIZE (4096)
+
+/*! Default number of sampled windows. */
+#define DEFAULT_WINDOWS (16)
+
+/*! Larger data than one window are sampled by at most this fraction. */
+#define SAMPLE_FRACTION (8)
+
+/*! Minimal size of window shrunk to the sampling budget. */
+#define MIN_WINDOW_SIZE (256)
+
+/*! Size of hybrid stream header. */
+#define HYBRID_HEADER_SIZE (5)
+
+/*! Minimal run stored by the hybrid codec as run section. */
+#define HYBRID_MIN_RUN (8)
+
+/*! Number of values in one bit-packed group of the hybrid codec. */
+#define HYBRID_GROUP_SIZE (8)
+
+/*! Size of entropy coded stream header and code length tables. */
+#define ENTROPY_HEADER_SIZE (12 + 2 * (128 + 4))
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static uint64_t windowStart(uint32_t len, uint32_t windowSize,
+                            uint32_t windows, uint32_t k);
+static uint32_t countRuns(const uint8_t *in, uint32_t n);
+static uint32_t varintSize(uint32_t value);
+static uint64_t hybridCost(const uint8_t *in, uint32_t n, uint8_t bitWidth);
+static double entropyCost(const uint8_t *tokens, uint32_t size,
+                          const uint8_t *headerBits, const uint8_t *valueBits,
+                          bool exact);
+static void symbolBits(const uint64_t *freq, uint8_t *bits);
+static void addCost(CostSums *sums, double cost, uint32_t n);
+static void finishEstimate(const CostSums *sums, uint32_t windows,
+                           uint32_t len, bool exact, uint64_t overhead,
+                           uint64_t *size, uint64_t *error);
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_estimate(const uint8_t *in, uint32_t len,
+                       const RLE_EstimateOptions *options,
+                       RLE_Estimate *estimate) {
+  if (in == NULL || len == 0 || estimate == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t windowSize = DEFAULT_WINDOW_SIZE;
+  uint32_t windows = DEFAULT_WINDOWS;
+  if (options != NULL && options->windowSize != 0) {
+    windowSize = options->windowSize;
+  }
+  if (options != NULL && options->windows != 0) {
+    windows = options->windows;
+  }
+
+  // Data of one window are sampled completely. Larger data are sampled by
+  // at most 1 / SAMPLE_FRACTION. The windows are shrunk first, the error
+  // bound needs their number, and then reduced to at least two windows.
+  bool exact = len <= windowSize;
+  uint32_t budget = len / SAMPLE_FRACTION;
+  if (exact) {
+    windowSize = len;
+    windows = 1;
+  } else if ((uint64_t)windowSize * windows > budget) {
+    uint32_t minSize =
+        windowSize < MIN_WINDOW_SIZE ? windowSize : MIN_WINDOW_SIZE;
+    windowSize = budget / windows;
+    if (windowSize < minSize) {
+      windowSize = minSize;
+      windows = budget / windowSize;
+    }
+    if (windows < 2) {
+      windows = 2;
+      windowSize = budget / 2 > 0 ? budget / 2 : 1;
+    }
+  }
+
+  // Every window is tokenized once, its tokens are kept for the costs of
+  // all modes.
+  uint64_t bound = rleEncodeBound(windowSize);
+  uint64_t workSize = (sizeof(uint32_t) + bound) * windows;
+  uint32_t *sizes = workSize <= SIZE_MAX ? malloc(workSize) : NULL;
+  if (sizes == NULL) {
+    return RLE_ERROR;
+  }
+  uint8_t *tokens = (uint8_t *)&sizes[windows];
+
+  // The first pass collects the symbol statistics of entropy coding and the
+  // bit width of hybrid codec, both are global for the whole data.
+  CostSums sums[RLE_MODE_COUNT] = {{0, 0, 0}};
+  uint64_t headerFreq[256] = {0};
+  uint64_t valueFreq[256] = {0};
+  uint64_t runs = 0;
+  uint64_t sampled = 0;
+  uint8_t bitWidth = 1;
+
+  for (uint32_t k = 0; k < windows; k++) {
+    uint64_t start = windowStart(len, windowSize, windows, k);
+    const uint8_t *window = &in[start];
+    uint32_t n = len - start < windowSize ? (uint32_t)(len - start)
+                                          : windowSize;
+    uint8_t *windowTokens = &tokens[bound * k];
+    uint32_t consumed;
+    uint32_t size = rleEncodeTokens(window, n, windowTokens, true, &consumed);
+    sizes[k] = size;
+
+    for (uint32_t i = 0; i < size;) {
+      RleToken token;
+      uint32_t start = i;
+      rleReadToken(windowTokens, size, &i, &token);
+      for (uint32_t h = start; h < i; h++) {
+        (&windowTokens[h] < token.data ? headerFreq
+                                       : valueFreq)[windowTokens[h]]++;
+      }
+    }
+
+    uint8_t width = RLE_hybrid_bit_width(window, n);
+    bitWidth = width > bitWidth ? width : bitWidth;
+
+    addCost(&sums[RLE_MODE_BASIC], size, n);
+    runs += countRuns(window, n);
+    sampled += n;
+  }
+
+  uint8_t headerBits[256];
+  uint8_t valueBits[256];
+  symbolBits(headerFreq, headerBits);
+  symbolBits(valueFreq, valueBits);
+
+  for (uint32_t k = 0; k < windows; k++) {
+    uint64_t start = windowStart(len, windowSize, windows, k);
+    const uint8_t *window = &in[start];
+    uint32_t n = len - start < windowSize ? (uint32_t)(len - start)
+                                          : windowSize;
+
+    addCost(&sums[RLE_MODE_HYBRID], (double)hybridCost(window, n, bitWidth),
+            n);
+    addCost(&sums[RLE_MODE_ENTROPY],
+            entropyCost(&tokens[bound * k], sizes[k], headerBits, valueBits,
+                        exact),
+            n);
+  }
+  free(sizes);
+
+  const uint64_t overhead[RLE_MODE_COUNT] = {0, HYBRID_HEADER_SIZE,
+                                             ENTROPY_HEADER_SIZE};
+  for (int mode = 0; mode < RLE_MODE_COUNT; mode++) {
+    finishEstimate(&sums[mode], windows, len, exact, overhead[mode],
+                   &estimate->size[mode], &estimate->error[mode]);
+  }
+
+  estimate->runs = (uint64_t)((double)runs * len / sampled + 0.5);
+  estimate->sampled = sampled;
+
+  return RLE_OK;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Returns the start of the \a k-th sampled window. The windows are spread
+ * evenly from the start to the end of data.
+ *
+ * \param[in]   len         Length of data.
+ * \param[in]   windowSize  Size of window.
+ * \param[in]   windows     Number of windows.
+ * \param[in]   k           Index of window.
+ *
+ * \return Offset of the window.
+ */
+static uint64_t windowStart(uint32_t len, uint32_t windowSize,
+                            uint32_t windows, uint32_t k) {
+  if (windows == 1) {
+    return 0;
+  }
+
+  return (uint64_t)k * (len - windowSize) / (windows - 1);
+}
+
+/*! Counts the runs of equal bytes. The loop has no branches depending on the
+ * data, so the compiler vectorizes the comparisons.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   n       Length of input array, at least one.
+ *
+ * \return Number of runs.
+ */
+static uint32_t countRuns(const uint8_t *in, uint32_t n) {
+  uint32_t transitions = 0;
+
+  for (uint32_t i = 1; i < n; i++) {
+    transitions += in[i] != in[i - 1];
+  }
+
+  return transitions + 1;
+}
+
+/*! Returns the size of ULEB128 encoded \a value.
+ *
+ * \param[in]   value   Encoded value.
+ *
+ * \return Size in bytes.
+ */
+static uint32_t varintSize(uint32_t value) {
+  uint32_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+
+  return size;
+}
+
+/*! Computes the size of sections of the hybrid codec for one window. The
+ * padding of bit-packed groups follows \ref RLE_hybrid_encode.
+ *
+ * \param[in]   in        Window data.
+ * \param[in]   n         Window size.
+ * \param[in]   bitWidth  Bit width of values.
+ *
+ * \return Size of sections in bytes.
+ */
+static uint64_t hybridCost(const uint8_t *in, uint32_t n, uint8_t bitWidth) {
+  uint64_t cost = 0;
+  uint32_t literal = 0;
+  uint32_t i = 0;
+
+  while (i < n) {
+    uint32_t j = i + 1;
+    while (j < n && in[j] == in[i]) j++;
+
+    uint32_t run = j - i;
+    uint32_t pad = (HYBRID_GROUP_SIZE - (i - literal) % HYBRID_GROUP_SIZE) %
+                   HYBRID_GROUP_SIZE;
+    if (run >= HYBRID_MIN_RUN && run - pad >= HYBRID_MIN_RUN) {
+      uint32_t groups = (i + pad - literal) / HYBRID_GROUP_SIZE;
+      if (groups > 0) {
+        cost += varintSize(groups << 1 | 1) + groups * bitWidth;
+      }
+      cost += varintSize((run - pad) << 1) + 1;
+      literal = j;
+    }
+    i = j;
+  }
+
+  if (n > literal) {
+    uint32_t groups = (n - literal + HYBRID_GROUP_SIZE - 1) / HYBRID_GROUP_SIZE;
+    cost += varintSize(groups << 1 | 1) + groups * bitWidth;
+  }
+
+  return cost;
+}
+
+/*! Computes the entropy coded size of window tokens. Both bitstreams of the
+ * complete data are padded to whole bytes as in \ref RLE_encode_entropy, the
+ * sampled windows are costed without padding.
+ *
+ * \param[in]   tokens      Encoded tokens of the window.
+ * \param[in]   size        Size of tokens.
+ * \param[in]   headerBits  Code lengths of header symbols.
+ * \param[in]   valueBits   Code lengths of value symbols.
+ * \param[in]   exact       True if the window covers the whole data.
+ *
+ * \return Size in bytes.
+ */
+static double entropyCost(const uint8_t *tokens, uint32_t size,
+                          const uint8_t *headerBits, const uint8_t *valueBits,
+                          bool exact) {
+  uint64_t header = 0;
+  uint64_t value = 0;
+
+  for (uint32_t i = 0; i < size;) {
+    RleToken token;
+    uint32_t start = i;
+    rleReadToken(tokens, size, &i, &token);
+    for (uint32_t h = start; h < i; h++) {
+      if (&tokens[h] < token.data) {
+        header += headerBits[tokens[h]];
+      } else {
+        value += valueBits[tokens[h]];
+      }
+    }
+  }
+
+  if (exact) {
+    return (double)((header + 7) / 8 + (value + 7) / 8);
+  }
+
+  return (double)(header + value) / 8;
+}
+
+/*! Computes the code lengths of \ref RLE_encode_entropy from symbol
+ * frequencies. Frequencies of huge data saturate, which only flattens the
+ * code of the estimate.
+ *
+ * \param[in]   freq    Symbol frequencies.
+ * \param[out]  bits    Code lengths in bits.
+ */
+static void symbolBits(const uint64_t *freq, uint8_t *bits) {
+  uint32_t weights[256];
+
+  for (int s = 0; s < 256; s++) {
+    weights[s] = freq[s] < UINT32_MAX ? (uint32_t)freq[s] : UINT32_MAX;
+  }
+
+  rleHuffmanLengths(weights, bits);
+}
+
+/*! Adds \a cost of a window of \a n bytes to the \a sums.
+ *
+ * \param[in,out] sums    Sums of window costs.
+ * \param[in]     cost    Window cost in bytes.
+ * \param[in]     n       Window size.
+ */
+static void addCost(CostSums *sums, double cost, uint32_t n) {
+  double ratio = cost / n;
+
+  sums->cost += cost;
+  sums->ratio += ratio;
+  sums->ratio2 += ratio * ratio;
+}
+
+/*! Extrapolates the sampled costs to the whole data and computes the error
+ * bound from the variance of window cost ratios.
+ *
+ * \param[in]   sums      Sums of window costs.
+ * \param[in]   windows   Number of windows.
+ * \param[in]   len       Length of data.
+ * \param[in]   exact     True if the data are sampled completely.
+ * \param[in]   overhead  Fixed size of headers.
+ * \param[out]  size      Estimated size.
+ * \param[out]  error     Error bound.
+ */
+static void finishEstimate(const CostSums *sums, uint32_t windows,
+                           uint32_t len, bool exact, uint64_t overhead,
+                           uint64_t *size, uint64_t *error) {
+  double mean = sums->ratio / windows;
+
+  if (exact) {
+    *size = overhead + (uint64_t)(sums->cost + 0.5);
+  } else {
+    *size = overhead + (uint64_t)(mean * len + 0.5);
+  }
+
+  if (exact) {
+    *error = 0;
+  } else if (windows < 2) {
+    // The variance is unknown, nothing better than the whole size.
+    *error = *size > len ? *size : len;
+  } else {
+    double variance = (sums->ratio2 - mean * sums->ratio) / (windows - 1);
+    variance = variance > 0 ? variance : 0;
+    *error = (uint64_t)(2 * sqrt(variance / windows) * len + 0.5);
+  }
+}
@@ -0,0 +1,142 @@
+/*!
+ * \file    rle_fd.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of RLE decoding directly to file descriptors.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_fd.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/*! Number of segments flushed by one writev call. */
+#if defined(IOV_MAX) && IOV_MAX < 256
+#define IOV_BATCH (IOV_MAX)
+#else
+#define IOV_BATCH (256)
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/*! Runs of every possible value, the segments of run tokens point to them. */
+static uint8_t runTable[256][MAX_COUNT];
+
+/*! Guard of the single initialization of \ref runTable. */
+static pthread_once_t runTableOnce = PTHREAD_ONCE_INIT;
+
+/* Private function declarations ---------------------------------------------*/
+static void fillRunTable(void);
+static bool writeSegments(int fd, struct iovec *iov, int count);
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_decode_fd(const uint8_t *in, uint32_t len, int fd,
+                        uint64_t *written) {
+  if (in == NULL || len == 0 || fd < 0) {
+    return RLE_ERROR;
+  }
+
+  uint64_t size;
+  if (rleScanDecodedSize(in, len, UINT64_MAX, &size) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  if (pthread_once(&runTableOnce, fillRunTable) != 0) {
+    return RLE_ERROR;
+  }
+
+  struct iovec iov[IOV_BATCH];
+  int segments = 0;
+  RLE_State state = RLE_OK;
+  uint32_t i = 0;
+
+  while (i < len) {
+    RleToken token;
+    rleReadToken(in, len, &i, &token);
+
+    if (token.literal) {
+      iov[segments].iov_base = (void *)token.data;
+    } else {
+      iov[segments].iov_base = runTable[token.data[0]];
+    }
+    iov[segments++].iov_len = token.count;
+
+    if (segments == IOV_BATCH) {
+      if (!writeSegments(fd, iov, segments)) {
+        state = RLE_ERROR;
+        break;
+      }
+      segments = 0;
+    }
+  }
+
+  if (state == RLE_OK && !writeSegments(fd, iov, segments)) {
+    state = RLE_ERROR;
+  }
+
+  if (state == RLE_OK && written != NULL) {
+    *written = size;
+  }
+
+  return state;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Fills \ref runTable, it is called once per process. */
+static void fillRunTable(void) {
+  for (uint32_t value = 0; value < 256; value++) {
+    memset(runTable[value], (int)value, MAX_COUNT);
+  }
+}
+
+/*! Writes all \a iov segments to \a fd, repeating the call after short writes
+ * and interrupts. A write of no bytes is an error, it would be repeated
+ * forever. The \a iov array is modified.
+ *
+ * \param[in]     fd      File descriptor opened for writing.
+ * \param[in,out] iov     Segments to write.
+ * \param[in]     count   Number of segments.
+ *
+ * \return Returns true if all data were written, false otherwise.
+ */
+static bool writeSegments(int fd, struct iovec *iov, int count) {
+  while (count > 0) {
+    ssize_t n = writev(fd, iov, count);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (n == 0) {
+      return false;
+    }
+
+    size_t done = (size_t)n;
+    while (count > 0 && done >= iov->iov_len) {
+      done -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if (count > 0) {
+      iov->iov_base = (uint8_t *)iov->iov_base + done;
+      iov->iov_len -= done;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,131 @@
+/*!
+ * \file    rle_file.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of RLE coding of files within a memory budget.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_file.h"
+
+#include <stddef.h>
+
+#include "rle_io.h"
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/*! Minimal size of the chunk. */
+#define MIN_CHUNK (4096)
+
+/*! Maximal size of the chunk, larger chunks do not pay off. */
+#define MAX_CHUNK (1u << 30)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static uint64_t memoryBudget(const RLE_FileOptions *options);
+static uint32_t encodeChunk(uint64_t budget);
+static uint32_t decodeChunk(uint64_t budget);
+
+/* Exported functions definitions --------------------------------------------*/
+uint64_t RLE_file_min_memory(void) {
+  return rleEncodeMemory(MIN_CHUNK);
+}
+
+RLE_State RLE_encode_file(FILE *in, FILE *out, const RLE_FileOptions *options,
+                          uint64_t *read, uint64_t *written) {
+  RLE_Source source;
+  RLE_Sink sink;
+
+  if (RLE_source_file(in, &source) != RLE_OK ||
+      RLE_sink_file(out, &sink) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  uint32_t chunk = encodeChunk(memoryBudget(options));
+  if (chunk == 0) {
+    return RLE_ERROR;
+  }
+
+  return rleEncodeChunks(&source, &sink, chunk, read, written);
+}
+
+RLE_State RLE_decode_file(FILE *in, FILE *out, const RLE_FileOptions *options,
+                          uint64_t *read, uint64_t *written) {
+  RLE_Source source;
+  RLE_Sink sink;
+
+  if (RLE_source_file(in, &source) != RLE_OK ||
+      RLE_sink_file(out, &sink) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  uint32_t chunk = decodeChunk(memoryBudget(options));
+  if (chunk == 0) {
+    return RLE_ERROR;
+  }
+
+  return rleDecodeChunks(&source, &sink, chunk, read, written);
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Returns the memory budget selected by the \a options.
+ *
+ * \param[in]   options   File coding options, may be NULL.
+ *
+ * \return Memory budget in bytes.
+ */
+static uint64_t memoryBudget(const RLE_FileOptions *options) {
+  if (options == NULL || options->maxMemory == 0) {
+    return RLE_FILE_DEFAULT_MEMORY;
+  }
+
+  return options->maxMemory;
+}
+
+/*! Computes the largest input chunk of the encoder, whose workspace fits to
+ * the \a budget.
+ *
+ * \param[in]   budget    Memory budget in bytes.
+ *
+ * \return Chunk size, zero if the budget is too low.
+ */
+static uint32_t encodeChunk(uint64_t budget) {
+  if (budget < RLE_file_min_memory()) {
+    return 0;
+  }
+
+  // The workspace holds the chunk and a larger output buffer, so half of the
+  // budget is too much. Each byte of the chunk takes at least two bytes of
+  // the workspace, shrinking the chunk by half of the excess shrinks the
+  // workspace by at least the excess.
+  uint64_t chunk = budget / 2 > MAX_CHUNK ? MAX_CHUNK : budget / 2;
+  while (rleEncodeMemory((uint32_t)chunk) > budget) {
+    chunk -= (rleEncodeMemory((uint32_t)chunk) - budget + 1) / 2;
+  }
+
+  return (uint32_t)chunk;
+}
+
+/*! Computes the chunk of the decoder, whose workspace fits to the \a budget.
+ * The input and the output chunk have the same size.
+ *
+ * \param[in]   budget    Memory budget in bytes.
+ *
+ * \return Chunk size, zero if the budget is too low.
+ */
+static uint32_t decodeChunk(uint64_t budget) {
+  if (budget < RLE_file_min_memory()) {
+    return 0;
+  }
+
+  uint64_t chunk = (budget - rleDecodeMemory(0)) / 2;
+
+  return chunk > MAX_CHUNK ? MAX_CHUNK : (uint32_t)chunk;
+}
@@ -0,0 +1,394 @@
+/*!
+ * \file    rle_hybrid.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of hybrid RLE / bit-packing codec.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_hybrid.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/*! Size of the stream header, bit width and 32 bit number of values. */
+#define HEADER_SIZE (5)
+
+/*! Number of values in one bit-packed group. */
+#define GROUP_SIZE (8)
+
+/*! Minimal length of run stored as run section. */
+#define MIN_RUN (8)
+
+/*! Maximal length of one run section, the header must fit to 32 bits. */
+#define MAX_RUN (0x7fffffffu)
+
+/*! Maximal size of ULEB128 encoded 32 bit number. */
+#define VARINT_MAX (5)
+
+/*! Unpacks one group of 8 values with constant bit width \a BW from 64 bit
+ * word \a W. The constant width lets the compiler turn the shifts to vector
+ * or immediate operations.
+ */
+#define UNPACK_GROUP(BW, W, OUT)                         \
+  do {                                                   \
+    for (unsigned k_ = 0; k_ < GROUP_SIZE; k_++) {       \
+      (OUT)[k_] = (uint8_t)((W) >> (k_ * (BW))) &        \
+                  (uint8_t)((1u << (BW)) - 1u);          \
+    }                                                    \
+  } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static uint8_t *writeVarint(uint8_t *out, uint32_t value);
+static bool readVarint(const uint8_t *in, uint32_t len, uint32_t *pos,
+                       uint32_t *value);
+static uint8_t *packGroups(const uint8_t *in, uint32_t count, uint8_t bitWidth,
+                           uint8_t *out);
+static void unpackGroups(const uint8_t *in, uint32_t groups, uint8_t bitWidth,
+                         uint8_t *out);
+static uint32_t runLength(const uint8_t *in, uint32_t len, uint32_t i);
+static uint32_t readCount(const uint8_t *in);
+static bool scanSections(const uint8_t *in, uint32_t len, uint8_t *out);
+
+/* Exported functions definitions --------------------------------------------*/
+uint8_t RLE_hybrid_bit_width(const uint8_t *in, uint32_t len) {
+  uint8_t bits = 0;
+
+  for (uint32_t i = 0; in != NULL && i < len; i++) {
+    bits |= in[i];
+  }
+
+  uint8_t width = 1;
+  while (width < 8 && (bits >> width) != 0) width++;
+
+  return width;
+}
+
+RLE_State RLE_hybrid_encode(const uint8_t *in, uint32_t len, uint8_t bitWidth,
+                            RLE_Data *result) {
+  if (in == NULL || len == 0 || result == NULL || bitWidth > 8) {
+    return RLE_ERROR;
+  }
+
+  uint8_t minimal = RLE_hybrid_bit_width(in, len);
+  if (bitWidth == 0) {
+    bitWidth = minimal;
+  } else if (bitWidth < minimal) {
+    return RLE_ERROR;
+  }
+
+  // every section costs at most a header and a value, bit-packed data are
+  // padded to whole group only once at the end
+  uint64_t sections = 2 * ((uint64_t)len / MIN_RUN) + 2;
+  uint64_t bound = HEADER_SIZE + sections * (VARINT_MAX + 1) +
+                   ((uint64_t)len + GROUP_SIZE) / GROUP_SIZE * bitWidth;
+  if (bound > UINT32_MAX) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data = malloc(bound);
+  if (data == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *o = data;
+  *o++ = bitWidth;
+  for (int b = 0; b < 32; b += 8) {
+    *o++ = (uint8_t)(len >> b);
+  }
+
+  uint32_t literal = 0;
+  uint32_t i = 0;
+  while (i < len) {
+    uint32_t run = runLength(in, len, i);
+    run = run < MAX_RUN ? run : MAX_RUN;
+
+    if (run >= MIN_RUN) {
+      // the bit-packed values before the run must fill whole groups
+      uint32_t pad = (GROUP_SIZE - (i - literal) % GROUP_SIZE) % GROUP_SIZE;
+      if (run - pad >= MIN_RUN) {
+        i += pad;
+        run -= pad;
+        if (i > literal) {
+          o = writeVarint(o, ((i - literal) / GROUP_SIZE) << 1 | 1);
+          o = packGroups(&in[literal], i - literal, bitWidth, o);
+        }
+        o = writeVarint(o, run << 1);
+        *o++ = in[i];
+        i += run;
+        literal = i;
+        continue;
+      }
+    }
+    i += run;
+  }
+
+  if (len > literal) {
+    uint32_t groups = (len - literal + GROUP_SIZE - 1) / GROUP_SIZE;
+    o = writeVarint(o, groups << 1 | 1);
+    o = packGroups(&in[literal], len - literal, bitWidth, o);
+  }
+
+  uint32_t size = (uint32_t)(o - data);
+  uint8_t *p = realloc(data, size);
+
+  result->data = p != NULL ? p : data;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_hybrid_decode(const uint8_t *in, uint32_t len,
+                            RLE_Data *result) {
+  return RLE_hybrid_decode_ex(in, len, NULL, result);
+}
+
+RLE_State RLE_hybrid_decode_ex(const uint8_t *in, uint32_t len,
+                               const RLE_DecodeOptions *options,
+                               RLE_Data *result) {
+  if (in == NULL || len < HEADER_SIZE || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  // A run section of a few bytes may claim any count, so the count is checked
+  // before the sections are walked and the result is allocated.
+  uint32_t count = readCount(in);
+  if (count > rleDecodeLimit(len, options)) {
+    return RLE_ERROR_LIMIT;
+  }
+  if (!scanSections(in, len, NULL)) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data = malloc(count);
+  if (data == NULL) {
+    return RLE_ERROR;
+  }
+
+  scanSections(in, len, data);
+  result->data = data;
+  result->size = count;
+
+  return RLE_OK;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Writes \a value as ULEB128 varint.
+ *
+ * \param[out]  out     Output buffer for at least 5 bytes.
+ * \param[in]   value   Written value.
+ *
+ * \return Pointer behind the written varint.
+ */
+static uint8_t *writeVarint(uint8_t *out, uint32_t value) {
+  while (value >= 0x80) {
+    *out++ = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (uint8_t)value;
+
+  return out;
+}
+
+/*! Reads ULEB128 varint at \a pos and moves \a pos behind it.
+ *
+ * \param[in]     in      Encoded input array.
+ * \param[in]     len     Length of input array.
+ * \param[in,out] pos     Position of the varint.
+ * \param[out]    value   Read value.
+ *
+ * \return Returns false for truncated, too long or overflowing varint, true
+ * otherwise.
+ */
+static bool readVarint(const uint8_t *in, uint32_t len, uint32_t *pos,
+                       uint32_t *value) {
+  uint32_t result = 0;
+
+  for (int shift = 0; shift < 35 && *pos < len; shift += 7) {
+    uint8_t byte = in[(*pos)++];
+    if (shift == 28 && byte > 0x0f) {
+      // the last byte holds the top four bits only
+      return false;
+    }
+    result |= (uint32_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*! Bit-packs \a count values to groups of 8 values, the last group is padded
+ * by zeros.
+ *
+ * \param[in]   in        Values to pack.
+ * \param[in]   count     Number of values.
+ * \param[in]   bitWidth  Number of bits per value.
+ * \param[out]  out       Output buffer.
+ *
+ * \return Pointer behind the packed data.
+ */
+static uint8_t *packGroups(const uint8_t *in, uint32_t count, uint8_t bitWidth,
+                           uint8_t *out) {
+  for (uint32_t i = 0; i < count; i += GROUP_SIZE) {
+    uint64_t word = 0;
+    uint32_t n = count - i < GROUP_SIZE ? count - i : GROUP_SIZE;
+
+    for (uint32_t k = 0; k < n; k++) {
+      word |= (uint64_t)in[i + k] << (k * bitWidth);
+    }
+    for (uint8_t b = 0; b < bitWidth; b++) {
+      *out++ = (uint8_t)(word >> (8 * b));
+    }
+  }
+
+  return out;
+}
+
+/*! Unpacks \a groups groups of 8 values. Each group is loaded as one 64 bit
+ * word and split by shifts specialized for the bit width.
+ *
+ * \param[in]   in        Packed data.
+ * \param[in]   groups    Number of groups.
+ * \param[in]   bitWidth  Number of bits per value.
+ * \param[out]  out       Output buffer for 8 values per group.
+ */
+static void unpackGroups(const uint8_t *in, uint32_t groups, uint8_t bitWidth,
+                         uint8_t *out) {
+  for (uint32_t g = 0; g < groups; g++, in += bitWidth, out += GROUP_SIZE) {
+    uint64_t word = 0;
+    for (uint8_t b = 0; b < bitWidth; b++) {
+      word |= (uint64_t)in[b] << (8 * b);
+    }
+
+    switch (bitWidth) {
+      case 1:
+        UNPACK_GROUP(1, word, out);
+        break;
+      case 2:
+        UNPACK_GROUP(2, word, out);
+        break;
+      case 3:
+        UNPACK_GROUP(3, word, out);
+        break;
+      case 4:
+        UNPACK_GROUP(4, word, out);
+        break;
+      case 5:
+        UNPACK_GROUP(5, word, out);
+        break;
+      case 6:
+        UNPACK_GROUP(6, word, out);
+        break;
+      case 7:
+        UNPACK_GROUP(7, word, out);
+        break;
+      default:
+        memcpy(out, in, GROUP_SIZE);
+        break;
+    }
+  }
+}
+
+/*! Returns the number of values equal to \a in[i] starting at \a i.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   i       Start of the run.
+ *
+ * \return Length of the run.
+ */
+static uint32_t runLength(const uint8_t *in, uint32_t len, uint32_t i) {
+  uint32_t j = i + 1;
+  while (j < len && in[j] == in[i]) j++;
+
+  return j - i;
+}
+
+/*! Reads the number of values from the stream header.
+ *
+ * \param[in]   in      Encoded input array.
+ *
+ * \return Number of encoded values.
+ */
+static uint32_t readCount(const uint8_t *in) {
+  uint32_t count = 0;
+  for (int b = 0; b < 4; b++) {
+    count |= (uint32_t)in[1 + b] << (8 * b);
+  }
+
+  return count;
+}
+
+/*! Walks the sections of encoded stream. Without \a out it only validates the
+ * stream, so nothing is allocated for malformed input. With \a out it decodes
+ * the already validated stream.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  out     Output buffer for all values, NULL to validate.
+ *
+ * \return Returns true if the stream is valid, false otherwise.
+ */
+static bool scanSections(const uint8_t *in, uint32_t len, uint8_t *out) {
+  uint8_t bitWidth = in[0];
+  uint32_t count = readCount(in);
+  uint32_t pos = HEADER_SIZE;
+  uint32_t produced = 0;
+  uint32_t header;
+
+  if (bitWidth == 0 || bitWidth > 8 || count == 0) {
+    return false;
+  }
+
+  while (produced < count && readVarint(in, len, &pos, &header)) {
+    uint32_t n = header >> 1;
+    uint32_t left = count - produced;
+
+    if (header & 1) {
+      // bit-packed groups, the padding of the last group is dropped
+      if (n == 0 || (uint64_t)n * bitWidth > len - pos ||
+          (uint64_t)(n - 1) * GROUP_SIZE >= left) {
+        return false;
+      }
+
+      uint32_t whole = left / GROUP_SIZE < n ? left / GROUP_SIZE : n;
+      if (out != NULL) {
+        unpackGroups(&in[pos], whole, bitWidth, &out[produced]);
+        if (whole < n) {
+          uint8_t last[GROUP_SIZE];
+          unpackGroups(&in[pos + whole * bitWidth], 1, bitWidth, last);
+          memcpy(&out[produced + whole * GROUP_SIZE], last,
+                 left - whole * GROUP_SIZE);
+        }
+      }
+      produced += whole < n ? left : whole * GROUP_SIZE;
+      pos += n * bitWidth;
+    } else {
+      if (n == 0 || n > left || pos >= len || (in[pos] >> bitWidth) != 0) {
+        return false;
+      }
+      if (out != NULL) {
+        memset(&out[produced], in[pos], n);
+      }
+      pos++;
+      produced += n;
+    }
+  }
+
+  return produced == count && pos == len;
+}
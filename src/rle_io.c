@@ -0,0 +1,534 @@
+/*!
+ * \file    rle_io.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of RLE coding between generic sources and sinks.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_io.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "rle_private.h"
+#include "rle_stream.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! Context of the sources backed by memory. */
+typedef struct {
+  const uint8_t *data; /*!< Source data. */
+  uint64_t size;       /*!< Size of data. */
+  uint64_t pos;        /*!< Position of the next read. */
+  bool mapped;         /*!< True if the data are mapped file. */
+} MemorySource;
+
+/*! Context of the memory sink. */
+typedef struct {
+  RLE_Data *result;  /*!< Collected data. */
+  uint32_t capacity; /*!< Allocated size of the result data. */
+} MemorySink;
+
+/*! Working memory of the encoder, the buffers follow the structure. */
+typedef struct {
+  RLE_Encoder encoder; /*!< Encoder state. */
+  uint8_t buffers[];   /*!< Input chunk followed by output buffer. */
+} EncodeWorkspace;
+
+/*! Working memory of the decoder, the buffers follow the structure. */
+typedef struct {
+  RLE_Decoder decoder; /*!< Decoder state. */
+  uint8_t buffers[];   /*!< Input chunk followed by output chunk. */
+} DecodeWorkspace;
+
+/* Private macros ------------------------------------------------------------*/
+/*! Initial capacity of the memory sink. */
+#define SINK_INITIAL_CAPACITY (4096)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static RLE_State readMemory(void *context, const uint8_t **data,
+                            uint32_t *size, uint8_t *buffer,
+                            uint32_t capacity);
+static void closeMemory(void *context);
+static RLE_State readFile(void *context, const uint8_t **data, uint32_t *size,
+                          uint8_t *buffer, uint32_t capacity);
+static RLE_State writeMemory(void *context, const uint8_t *data,
+                             uint32_t size);
+static RLE_State writeFile(void *context, const uint8_t *data, uint32_t size);
+#ifndef _WIN32
+static RLE_State readFd(void *context, const uint8_t **data, uint32_t *size,
+                        uint8_t *buffer, uint32_t capacity);
+static RLE_State writeFd(void *context, const uint8_t *data, uint32_t size);
+#endif
+static bool writeAll(const RLE_Sink *sink, const uint8_t *data, uint32_t size,
+                     uint64_t *written);
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_source_memory(const uint8_t *data, uint64_t size,
+                            RLE_Source *source) {
+  if ((data == NULL && size != 0) || source == NULL) {
+    return RLE_ERROR;
+  }
+
+  MemorySource *memory = malloc(sizeof(MemorySource));
+  if (memory == NULL) {
+    return RLE_ERROR;
+  }
+  memory->data = data;
+  memory->size = size;
+  memory->pos = 0;
+  memory->mapped = false;
+
+  source->read = readMemory;
+  source->close = closeMemory;
+  source->context = memory;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_source_file(FILE *file, RLE_Source *source) {
+  if (file == NULL || source == NULL) {
+    return RLE_ERROR;
+  }
+
+  source->read = readFile;
+  source->close = NULL;
+  source->context = file;
+
+  return RLE_OK;
+}
+
+void RLE_source_close(RLE_Source *source) {
+  if (source != NULL && source->close != NULL) {
+    source->close(source->context);
+    source->close = NULL;
+  }
+}
+
+RLE_State RLE_sink_memory(RLE_Data *result, RLE_Sink *sink) {
+  if (result == NULL || sink == NULL) {
+    return RLE_ERROR;
+  }
+
+  MemorySink *memory = malloc(sizeof(MemorySink));
+  if (memory == NULL) {
+    return RLE_ERROR;
+  }
+  memory->result = result;
+  memory->capacity = 0;
+  result->data = NULL;
+  result->size = 0;
+
+  sink->write = writeMemory;
+  sink->close = free;
+  sink->context = memory;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_sink_file(FILE *file, RLE_Sink *sink) {
+  if (file == NULL || sink == NULL) {
+    return RLE_ERROR;
+  }
+
+  sink->write = writeFile;
+  sink->close = NULL;
+  sink->context = file;
+
+  return RLE_OK;
+}
+
+void RLE_sink_close(RLE_Sink *sink) {
+  if (sink != NULL && sink->close != NULL) {
+    sink->close(sink->context);
+    sink->close = NULL;
+  }
+}
+
+#ifndef _WIN32
+RLE_State RLE_source_fd(int fd, RLE_Source *source) {
+  if (fd < 0 || source == NULL) {
+    return RLE_ERROR;
+  }
+
+  source->read = readFd;
+  source->close = NULL;
+  source->context = (void *)(intptr_t)fd;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_source_mmap(const char *path, RLE_Source *source) {
+  if (path == NULL || source == NULL) {
+    return RLE_ERROR;
+  }
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return RLE_ERROR;
+  }
+
+  struct stat info;
+  void *data = NULL;
+  bool ok = fstat(fd, &info) == 0;
+  if (ok && info.st_size > 0) {
+    data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ok = data != MAP_FAILED;
+    if (ok) {
+      madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+    }
+  }
+  close(fd);  // the mapping stays valid
+
+  MemorySource *memory = ok ? malloc(sizeof(MemorySource)) : NULL;
+  if (memory == NULL) {
+    if (ok && data != NULL) {
+      munmap(data, (size_t)info.st_size);
+    }
+    return RLE_ERROR;
+  }
+  memory->data = data;
+  memory->size = (uint64_t)info.st_size;
+  memory->pos = 0;
+  memory->mapped = true;
+
+  source->read = readMemory;
+  source->close = closeMemory;
+  source->context = memory;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_sink_fd(int fd, RLE_Sink *sink) {
+  if (fd < 0 || sink == NULL) {
+    return RLE_ERROR;
+  }
+
+  sink->write = writeFd;
+  sink->close = NULL;
+  sink->context = (void *)(intptr_t)fd;
+
+  return RLE_OK;
+}
+#endif
+
+RLE_State RLE_encode_io(const RLE_Source *source, const RLE_Sink *sink,
+                        uint64_t *read, uint64_t *written) {
+  if (source == NULL || source->read == NULL || sink == NULL ||
+      sink->write == NULL) {
+    return RLE_ERROR;
+  }
+
+  return rleEncodeChunks(source, sink, RLE_IO_CHUNK_SIZE, read, written);
+}
+
+RLE_State RLE_decode_io(const RLE_Source *source, const RLE_Sink *sink,
+                        uint64_t *read, uint64_t *written) {
+  if (source == NULL || source->read == NULL || sink == NULL ||
+      sink->write == NULL) {
+    return RLE_ERROR;
+  }
+
+  return rleDecodeChunks(source, sink, RLE_IO_CHUNK_SIZE, read, written);
+}
+
+/* Internal functions definitions --------------------------------------------*/
+uint64_t rleEncodeMemory(uint32_t chunk) {
+  return sizeof(EncodeWorkspace) + (uint64_t)chunk + RLE_encoder_bound(chunk);
+}
+
+uint64_t rleDecodeMemory(uint32_t chunk) {
+  return sizeof(DecodeWorkspace) + 2 * (uint64_t)chunk;
+}
+
+RLE_State rleEncodeChunks(const RLE_Source *source, const RLE_Sink *sink,
+                          uint32_t chunk, uint64_t *read, uint64_t *written) {
+  EncodeWorkspace *work = malloc(rleEncodeMemory(chunk));
+  if (work == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *inBuffer = work->buffers;
+  uint8_t *outBuffer = &work->buffers[chunk];
+  uint64_t total = 0;
+  uint64_t produced = 0;
+  bool ok;
+  const uint8_t *data;
+  uint32_t size;
+  uint32_t outLen;
+
+  RLE_encoder_init(&work->encoder);
+  do {
+    ok = source->read(source->context, &data, &size, inBuffer, chunk) ==
+             RLE_OK &&
+         RLE_encoder_feed(&work->encoder, data, size, outBuffer, &outLen) ==
+             RLE_OK &&
+         writeAll(sink, outBuffer, outLen, &produced);
+    total += ok ? size : 0;
+  } while (ok && size > 0);
+
+  ok = ok && total > 0 &&
+       RLE_encoder_finish(&work->encoder, outBuffer, &outLen) == RLE_OK &&
+       writeAll(sink, outBuffer, outLen, &produced);
+  free(work);
+
+  if (read != NULL) {
+    *read = total;
+  }
+  if (written != NULL) {
+    *written = produced;
+  }
+
+  return ok ? RLE_OK : RLE_ERROR;
+}
+
+RLE_State rleDecodeChunks(const RLE_Source *source, const RLE_Sink *sink,
+                          uint32_t chunk, uint64_t *read, uint64_t *written) {
+  DecodeWorkspace *work = malloc(rleDecodeMemory(chunk));
+  if (work == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *inBuffer = work->buffers;
+  uint8_t *outBuffer = &work->buffers[chunk];
+  uint64_t total = 0;
+  uint64_t produced = 0;
+  bool ok;
+  const uint8_t *data;
+  uint32_t size;
+  uint32_t left;
+
+  RLE_decoder_init(&work->decoder);
+  do {
+    ok = source->read(source->context, &data, &size, inBuffer, chunk) ==
+         RLE_OK;
+    total += ok ? size : 0;
+
+    // the output is full until the decoder consumes all input
+    uint32_t outLen = chunk;
+    left = size;
+    while (ok && outLen == chunk) {
+      ok = RLE_decoder_feed(&work->decoder, &data, &left, outBuffer, chunk,
+                            &outLen) == RLE_OK &&
+           writeAll(sink, outBuffer, outLen, &produced);
+    }
+  } while (ok && size > 0);
+
+  ok = ok && total > 0 && RLE_decoder_finish(&work->decoder) == RLE_OK;
+  free(work);
+
+  if (read != NULL) {
+    *read = total;
+  }
+  if (written != NULL) {
+    *written = produced;
+  }
+
+  return ok ? RLE_OK : RLE_ERROR;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Reads next data of memory source without copying them.
+ *
+ * \param[in]   context   Memory source.
+ * \param[out]  data      Pointer to the read data.
+ * \param[out]  size      Size of the read data.
+ * \param[out]  buffer    Unused buffer.
+ * \param[in]   capacity  Maximal size of read data.
+ *
+ * \return Returns \ref RLE_OK.
+ */
+static RLE_State readMemory(void *context, const uint8_t **data,
+                            uint32_t *size, uint8_t *buffer,
+                            uint32_t capacity) {
+  MemorySource *memory = context;
+  uint64_t left = memory->size - memory->pos;
+  (void)buffer;
+
+  *data = &memory->data[memory->pos];
+  *size = left < capacity ? (uint32_t)left : capacity;
+  memory->pos += *size;
+
+  return RLE_OK;
+}
+
+/*! Releases memory source, unmaps the mapped file.
+ *
+ * \param[in]   context   Memory source.
+ */
+static void closeMemory(void *context) {
+  MemorySource *memory = context;
+
+#ifndef _WIN32
+  if (memory->mapped && memory->size > 0) {
+    munmap((void *)memory->data, (size_t)memory->size);
+  }
+#endif
+  free(memory);
+}
+
+/*! Reads next data of stdio file.
+ *
+ * \param[in]   context   File opened for reading.
+ * \param[out]  data      Pointer to the read data.
+ * \param[out]  size      Size of the read data.
+ * \param[out]  buffer    Buffer for the read data.
+ * \param[in]   capacity  Size of buffer.
+ *
+ * \return If read error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+static RLE_State readFile(void *context, const uint8_t **data, uint32_t *size,
+                          uint8_t *buffer, uint32_t capacity) {
+  FILE *file = context;
+
+  *data = buffer;
+  *size = (uint32_t)fread(buffer, 1, capacity, file);
+
+  return *size == 0 && ferror(file) ? RLE_ERROR : RLE_OK;
+}
+
+/*! Appends data to the result of memory sink, its capacity is doubled when
+ * it is full.
+ *
+ * \param[in]   context   Memory sink.
+ * \param[in]   data      Written data.
+ * \param[in]   size      Size of data.
+ *
+ * \return If the result would exceed 4 GiB or allocation failed the
+ * \ref RLE_ERROR is returned, \ref RLE_OK otherwise.
+ */
+static RLE_State writeMemory(void *context, const uint8_t *data,
+                             uint32_t size) {
+  MemorySink *memory = context;
+  RLE_Data *result = memory->result;
+
+  if (size > UINT32_MAX - result->size) {
+    return RLE_ERROR;
+  }
+
+  if (result->size + size > memory->capacity) {
+    uint64_t capacity =
+        memory->capacity > 0 ? memory->capacity : SINK_INITIAL_CAPACITY;
+    while (capacity < result->size + size) {
+      capacity *= 2;
+    }
+    capacity = capacity > UINT32_MAX ? UINT32_MAX : capacity;
+
+    uint8_t *p = realloc(result->data, capacity);
+    if (p == NULL) {
+      return RLE_ERROR;
+    }
+    result->data = p;
+    memory->capacity = (uint32_t)capacity;
+  }
+
+  memcpy(&result->data[result->size], data, size);
+  result->size += size;
+
+  return RLE_OK;
+}
+
+/*! Writes data to stdio file.
+ *
+ * \param[in]   context   File opened for writing.
+ * \param[in]   data      Written data.
+ * \param[in]   size      Size of data.
+ *
+ * \return If write error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+static RLE_State writeFile(void *context, const uint8_t *data,
+                           uint32_t size) {
+  return fwrite(data, 1, size, context) == size ? RLE_OK : RLE_ERROR;
+}
+
+#ifndef _WIN32
+/*! Reads next data of file descriptor, repeating interrupted reads.
+ *
+ * \param[in]   context   File descriptor opened for reading.
+ * \param[out]  data      Pointer to the read data.
+ * \param[out]  size      Size of the read data.
+ * \param[out]  buffer    Buffer for the read data.
+ * \param[in]   capacity  Size of buffer.
+ *
+ * \return If read error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+static RLE_State readFd(void *context, const uint8_t **data, uint32_t *size,
+                        uint8_t *buffer, uint32_t capacity) {
+  int fd = (int)(intptr_t)context;
+  ssize_t n;
+
+  do {
+    n = read(fd, buffer, capacity);
+  } while (n < 0 && errno == EINTR);
+
+  *data = buffer;
+  *size = n > 0 ? (uint32_t)n : 0;
+
+  return n < 0 ? RLE_ERROR : RLE_OK;
+}
+
+/*! Writes data to file descriptor, repeating short and interrupted writes.
+ *
+ * \param[in]   context   File descriptor opened for writing.
+ * \param[in]   data      Written data.
+ * \param[in]   size      Size of data.
+ *
+ * \return If write error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+static RLE_State writeFd(void *context, const uint8_t *data, uint32_t size) {
+  int fd = (int)(intptr_t)context;
+
+  while (size > 0) {
+    ssize_t n = write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return RLE_ERROR;
+    }
+    data += n;
+    size -= (uint32_t)n;
+  }
+
+  return RLE_OK;
+}
+#endif
+
+/*! Writes \a size bytes of \a data to the \a sink.
+ *
+ * \param[in]     sink      Destination of data.
+ * \param[in]     data      Written data.
+ * \param[in]     size      Size of data.
+ * \param[in,out] written   Number of written bytes, increased by \a size.
+ *
+ * \return Returns false if the data were not written.
+ */
+static bool writeAll(const RLE_Sink *sink, const uint8_t *data, uint32_t size,
+                     uint64_t *written) {
+  if (size > 0 && sink->write(sink->context, data, size) != RLE_OK) {
+    return false;
+  }
+  *written += size;
+
+  return true;
+}
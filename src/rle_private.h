@@ -0,0 +1,504 @@
+/*!
+ * \file    rle_private.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declarations shared by the translation units of the RLE module.
+ *
+ * This header is not part of the public interface. It describes the token
+ * format and exposes the helpers, which are used by more than one source file.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+#ifndef RLE_PRIVATE_H
+#define RLE_PRIVATE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rle.h"
+#include "rle_io.h"
+
+/* Exported types ------------------------------------------------------------*/
+/*! One token of encoded data. */
+typedef struct {
+  const uint8_t *data; /*!< Run value or the first byte of literal block. */
+  uint32_t count;      /*!< Number of decoded bytes. */
+  bool literal;        /*!< True for literal or stored block, false for run. */
+} RleToken;
+
+/*! Statistics of the decoding table lookups of entropy coded data. */
+typedef struct {
+  uint64_t lookups; /*!< Number of table lookups. */
+  uint64_t pairs;   /*!< Number of lookups decoding two symbols. */
+} RleLookupStats;
+
+/* Exported constants --------------------------------------------------------*/
+/*! Flag in the token header marking the literal (non-repetitive) block. */
+#define LITERAL_FLAG (0x80)
+
+/*! Maximal count stored in the token header (bits 0:6). */
+#define MAX_COUNT (0x7f)
+
+/*! Header of stored block, i.e. literal block with zero count. The header is
+ * followed by 16 bit little endian length and the stored bytes. */
+#define STORED_HEADER (LITERAL_FLAG)
+
+/*! Size of stored block header including the length. */
+#define STORED_HEADER_SIZE (3)
+
+/*! Maximal length of stored block accepted by the decoder. */
+#define STORED_LIMIT (0xffff)
+
+/*! Maximal length of stored block produced by the encoder. */
+#define STORED_MAX (4096)
+
+/*! Minimal length of stored block produced by the encoder. Shorter literal
+ * data take at most three literal blocks, which cost the same. */
+#define STORED_MIN (3 * MAX_COUNT + 1)
+
+/*! Number of bytes starting at the tested position needed by
+ * \ref rleLiteralEnds to decide. */
+#define LITERAL_LOOKAHEAD (5)
+
+/*! Maximal number of bytes left by \ref rleEncodeTokens for the next call. */
+#define ENCODE_CARRY_MAX (STORED_MAX + LITERAL_LOOKAHEAD)
+
+/*! Number of positions tested at once by the word scans. */
+#define WORD_SIZE (8)
+
+/*! Word with each byte equal to one, multiplied by a value fills the word
+ * with the value. */
+#define WORD_ONES (0x0101010101010101ull)
+
+/*! Word with the top bit of each byte set. */
+#define WORD_HIGHS (0x8080808080808080ull)
+
+/*! Maximal length of token decoded by fixed size stores. */
+#define SHORT_TOKEN (2 * WORD_SIZE)
+
+/* Exported functions declarations -------------------------------------------*/
+/*! Returns the maximal size of data decoded from \a len bytes allowed by the
+ * \a options, at most UINT32_MAX.
+ *
+ * \param[in]   len     Length of encoded input.
+ * \param[in]   options Decoding limits, NULL means no limits.
+ *
+ * \return Maximal allowed size of decoded data.
+ */
+uint64_t rleDecodeLimit(uint32_t len, const RLE_DecodeOptions *options);
+
+/*! Walks the tokens of encoded input and computes the size of decoded data.
+ * The scan stops as soon as the size exceeds \a limit.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   limit   Maximal allowed size of decoded data.
+ * \param[out]  size    Size of decoded data.
+ *
+ * \return \ref RLE_ERROR for malformed input, \ref RLE_ERROR_LIMIT if the
+ * \a limit is exceeded, \ref RLE_OK otherwise.
+ */
+RLE_State rleScanDecodedSize(const uint8_t *in, uint32_t len, uint64_t limit,
+                             uint64_t *size);
+
+/*! Validates and decodes the tokens of \a in to the \a out buffer by one
+ * pass. Unlike \ref RLE_decode_into, part of \a out may be written before
+ * malformed input or the end of \a out is detected.
+ *
+ * \param[in]   in        Encoded input array.
+ * \param[in]   len       Length of input array.
+ * \param[out]  out       Output buffer.
+ * \param[in]   size      Size of output buffer.
+ * \param[out]  written   Size of decoded data.
+ *
+ * \return \ref RLE_ERROR for malformed input, \ref RLE_ERROR_LIMIT if the
+ * decoded data do not fit to \a out, \ref RLE_OK otherwise.
+ */
+RLE_State rleDecodeChecked(const uint8_t *in, uint32_t len, uint8_t *out,
+                           uint32_t size, uint32_t *written);
+
+/*! Encodes \a in array to the \a out buffer. A token, before which a literal
+ * block would end by \ref rleLiteralEnds, is a run, otherwise the bytes are
+ * collected to a literal block until \ref rleLiteralEnds. Literal data of at
+ * least \ref STORED_MIN bytes are written as stored blocks. The \a out buffer
+ * must hold at least \ref rleEncodeBound bytes.
+ *
+ * Unless \a final is set, the end of \a in is not the end of data. Then the
+ * encoding stops before the first token, whose end depends on the following
+ * data, and the caller must pass the remaining bytes again together with the
+ * next data. The remaining bytes never exceed \ref ENCODE_CARRY_MAX.
+ *
+ * \param[in]   in        Input array.
+ * \param[in]   len       Length of input array.
+ * \param[out]  out       Output buffer.
+ * \param[in]   final     True if \a in ends the data.
+ * \param[out]  consumed  Number of encoded input bytes.
+ *
+ * \return Number of bytes written to \a out.
+ */
+uint32_t rleEncodeTokens(const uint8_t *in, uint32_t len, uint8_t *out,
+                         bool final, uint32_t *consumed);
+
+/*! Decodes entropy coded data as \ref RLE_decode_entropy and collects the
+ * statistics of decoding table lookups.
+ *
+ * \param[in]   in      Encoded input array.
+ * \param[in]   len     Length of input array.
+ * \param[out]  result  Decoded data allocated on heap.
+ * \param[out]  stats   Statistics of table lookups, may be NULL.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+RLE_State rleDecodeEntropy(const uint8_t *in, uint32_t len, RLE_Data *result,
+                           RleLookupStats *stats);
+
+/*! Computes Huffman code lengths of entropy coding limited to 11 bits, as
+ * used by \ref RLE_encode_entropy.
+ *
+ * \param[in]   freq      Symbol frequencies of 256 symbols.
+ * \param[out]  lengths   Code lengths, zero for unused symbols.
+ */
+void rleHuffmanLengths(const uint32_t *freq, uint8_t *lengths);
+
+/*! Returns the memory used by \ref rleEncodeChunks with \a chunk.
+ *
+ * \param[in]   chunk   Size of the input chunk.
+ *
+ * \return Size of the workspace in bytes.
+ */
+uint64_t rleEncodeMemory(uint32_t chunk);
+
+/*! Returns the memory used by \ref rleDecodeChunks with \a chunk.
+ *
+ * \param[in]   chunk   Size of the input chunk and of the output tile.
+ *
+ * \return Size of the workspace in bytes.
+ */
+uint64_t rleDecodeMemory(uint32_t chunk);
+
+/*! Encodes all data of \a source to \a sink. The input is read in chunks of
+ * at most \a chunk bytes, the workspace takes \ref rleEncodeMemory bytes.
+ *
+ * \param[in]   source    Source of input data.
+ * \param[in]   sink      Destination of encoded data.
+ * \param[in]   chunk     Size of the input chunk.
+ * \param[out]  read      Number of read bytes, may be NULL.
+ * \param[out]  written   Number of written bytes, may be NULL.
+ *
+ * \return If error occure or the source is empty the \ref RLE_ERROR is
+ * returned, \ref RLE_OK otherwise.
+ */
+RLE_State rleEncodeChunks(const RLE_Source *source, const RLE_Sink *sink,
+                          uint32_t chunk, uint64_t *read, uint64_t *written);
+
+/*! Decodes all data of \a source to \a sink. The input is read in chunks of
+ * at most \a chunk bytes and decoded to tiles of \a chunk bytes, the
+ * workspace takes \ref rleDecodeMemory bytes.
+ *
+ * \param[in]   source    Source of encoded data.
+ * \param[in]   sink      Destination of decoded data.
+ * \param[in]   chunk     Size of the input chunk and of the output tile.
+ * \param[out]  read      Number of read bytes, may be NULL.
+ * \param[out]  written   Number of written bytes, may be NULL.
+ *
+ * \return If error occure or the source is empty the \ref RLE_ERROR is
+ * returned, \ref RLE_OK otherwise.
+ */
+RLE_State rleDecodeChunks(const RLE_Source *source, const RLE_Sink *sink,
+                          uint32_t chunk, uint64_t *read, uint64_t *written);
+
+/*! Returns the maximal size of \a len bytes encoded by \ref rleEncodeTokens.
+ * Every literal data but the last are followed by a run of at least three
+ * bytes, which saves one byte. Literal data of n bytes cost at most
+ * ceil(n / 127) headers, so the expansion is at most one byte per 127 bytes
+ * plus one.
+ *
+ * \param[in]   len     Length of input data.
+ *
+ * \return Maximal size of encoded data.
+ */
+static inline uint64_t rleEncodeBound(uint64_t len) {
+  return len + len / MAX_COUNT + 1;
+}
+
+/*! Decides whether the literal data being collected end before position
+ * \a j. They end before a run of at least three bytes and before a pair of
+ * equal bytes, which is followed by the end of data, by such run or by the
+ * last pair of data. Other pairs would save nothing as runs, so they stay in
+ * the literal data.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   j       Position following the literal data.
+ *
+ * \return Returns true if the literal data end before \a j.
+ */
+static inline bool rleLiteralEnds(const uint8_t *in, uint32_t len,
+                                  uint32_t j) {
+  if (len - j < 2 || in[j] != in[j + 1]) {
+    return false;
+  }
+  if (len - j == 2 || in[j + 2] == in[j]) {
+    return true;
+  }
+  if (len - j == 4) {
+    return in[j + 2] == in[j + 3];
+  }
+
+  return len - j >= 5 && in[j + 2] == in[j + 3] && in[j + 3] == in[j + 4];
+}
+
+/*! Loads unaligned word, whose first byte is the least significant one. The
+ * compilers merge the shifts to a single load on little endian targets.
+ *
+ * \param[in]   p       Position of the word.
+ *
+ * \return Loaded word.
+ */
+static inline uint64_t rleLoadWord(const uint8_t *p) {
+  return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 |
+         (uint64_t)p[3] << 24 | (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+         (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+/*! Marks zero bytes of the \a word by their top bit. Unlike the usual
+ * carry based test, the mask is exact, the bytes do not affect each other.
+ *
+ * \param[in]   word    Tested word.
+ *
+ * \return Mask with top bits of zero bytes set.
+ */
+static inline uint64_t rleZeroBytes(uint64_t word) {
+  const uint64_t low = ~WORD_HIGHS;
+  return ~(((word & low) + low) | word | low);
+}
+
+/*! Marks the positions of \a p word, whose byte equals the following one,
+ * i.e. the zero bytes of the word XOR-ed with itself shifted by one byte.
+ *
+ * \param[in]   p       Position of the word, \a p[8] must be readable.
+ *
+ * \return Mask with top bits of the bytes starting a pair set.
+ */
+static inline uint64_t rlePairs(const uint8_t *p) {
+  return rleZeroBytes(rleLoadWord(p) ^ rleLoadWord(p + 1));
+}
+
+/*! Returns index of the first byte marked in the non-zero \a mask. Without
+ * the count trailing zeros builtin, the lowest marked bit 8k + 7 is isolated
+ * and multiplied by a constant, whose byte 7 - k holds k.
+ *
+ * \param[in]   mask    Mask with top bits of marked bytes set.
+ *
+ * \return Index of the byte.
+ */
+static inline uint32_t rleFirstByte(uint64_t mask) {
+#if defined(__GNUC__)
+  return (uint32_t)__builtin_ctzll(mask) / 8;
+#else
+  uint64_t lowest = mask & (0 - mask);
+  return (uint32_t)(((lowest >> 7) * 0x0001020304050607ull) >> 56);
+#endif
+}
+
+/*! Finds the end of run of \a value, which continues at position \a j.
+ * Whole words are compared at once and the end is computed from the first
+ * differing byte, so short runs do not cost a mispredicted branch per
+ * byte.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   j       Position of the next tested byte.
+ * \param[in]   end     Position, where the run stops at the latest.
+ * \param[in]   value   Value of the run.
+ *
+ * \return Position following the run.
+ */
+static inline uint32_t rleRunEnd(const uint8_t *in, uint32_t j, uint32_t end,
+                                 uint8_t value) {
+  const uint64_t pattern = value * WORD_ONES;
+
+  while (end - j >= WORD_SIZE) {
+    uint64_t other = rleZeroBytes(rleLoadWord(&in[j]) ^ pattern) ^ WORD_HIGHS;
+    if (other != 0) {
+      return j + rleFirstByte(other);
+    }
+    j += WORD_SIZE;
+  }
+  while (j < end && in[j] == value) j++;
+
+  return j;
+}
+
+/*! Finds the first position from \a j, before which the literal data end by
+ * \ref rleLiteralEnds. Literal data of noisy input end at random positions,
+ * which a byte loop mispredicts. The rule of \ref rleLiteralEnds is thus
+ * evaluated for a word of positions at once by masks of pairs starting at
+ * the next four positions, which costs one predictable branch per word. The
+ * byte loop tests the positions near the end of data.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   j       Position of the first tested byte.
+ * \param[in]   stop    Position, where the literal data stop at the latest.
+ *
+ * \return Position following the literal data.
+ */
+static inline uint32_t rleLiteralEnd(const uint8_t *in, uint32_t len,
+                                     uint32_t j, uint32_t stop) {
+  // all tested positions and the four following bytes must be available
+  while (stop - j >= WORD_SIZE && len - j >= WORD_SIZE + 4) {
+    const uint8_t *p = &in[j];
+    uint64_t ends = rlePairs(p) & (rlePairs(p + 1) |
+                                   (rlePairs(p + 2) & rlePairs(p + 3)));
+    if (ends != 0) {
+      return j + rleFirstByte(ends);
+    }
+    j += WORD_SIZE;
+  }
+  while (j < stop && !rleLiteralEnds(in, len, j)) j++;
+
+  return j;
+}
+
+/*! Encodes one token starting at position \a i of \a in array as described
+ * in \ref rleEncodeTokens and moves \a out behind it.
+ *
+ * \param[in]     in      Input array.
+ * \param[in]     len     Length of input array.
+ * \param[in]     i       Position of the token, lower than \a len.
+ * \param[in]     final   True if \a in ends the data.
+ * \param[in,out] out     Output position.
+ *
+ * \return Position behind the encoded bytes, \a i if the token depends on the
+ * following data.
+ */
+static inline uint32_t rleEncodeToken(const uint8_t *in, uint32_t len,
+                                      uint32_t i, bool final, uint8_t **out) {
+  uint8_t *o = *out;
+  uint32_t j = i + 1;
+
+  if (!final && len - i < LITERAL_LOOKAHEAD) {
+    return i;  // the kind of token depends on the next data
+  }
+
+  if (rleLiteralEnds(in, len, i)) {
+    uint32_t end = len - i > MAX_COUNT ? i + MAX_COUNT : len;
+    j = rleRunEnd(in, j, end, in[i]);
+    if (j == len && j - i < MAX_COUNT && !final) {
+      return i;  // the run may continue in the next data
+    }
+    *o++ = (uint8_t)(j - i);
+    *o++ = in[i];
+  } else {
+    uint32_t end = len - i > STORED_MAX ? i + STORED_MAX : len;
+    if (!final && len - end < LITERAL_LOOKAHEAD - 1) {
+      end = len - (LITERAL_LOOKAHEAD - 1);  // the next data decide the rest
+    }
+    j = rleLiteralEnd(in, len, j, end);
+    if (!final && j - i < STORED_MAX && len - j < LITERAL_LOOKAHEAD) {
+      return i;  // the end of literal data depends on the next data
+    }
+
+    if (j - i >= STORED_MIN) {
+      *o++ = STORED_HEADER;
+      *o++ = (uint8_t)(j - i);
+      *o++ = (uint8_t)((j - i) >> 8);
+    } else {
+      // the rest of longer literal data starts the next token
+      j = j - i > MAX_COUNT ? i + MAX_COUNT : j;
+      *o++ = LITERAL_FLAG | (uint8_t)(j - i);
+    }
+    memcpy(o, &in[i], j - i);
+    o += j - i;
+  }
+
+  *out = o;
+  return j;
+}
+
+/*! Fills \a count bytes of \a out by \a value. Runs of at most
+ * \ref SHORT_TOKEN bytes are stored by two words unconditionally, if the
+ * output has room for them, so they cost neither a call of memset nor a
+ * mispredicted loop. The bytes written behind the run are overwritten by the
+ * following tokens.
+ *
+ * \param[out]  out     Output position.
+ * \param[in]   room    Number of bytes available at \a out.
+ * \param[in]   value   Value of the run.
+ * \param[in]   count   Length of the run, at most \a room.
+ */
+static inline void rleFillRun(uint8_t *out, uint32_t room, uint8_t value,
+                              uint32_t count) {
+  if (count > SHORT_TOKEN || room < SHORT_TOKEN) {
+    memset(out, value, count);
+    return;
+  }
+
+  const uint64_t pattern = value * WORD_ONES;
+  memcpy(out, &pattern, WORD_SIZE);
+  memcpy(&out[WORD_SIZE], &pattern, WORD_SIZE);
+}
+
+/*! Copies \a count bytes of literal data to \a out. Literal data of at most
+ * \ref SHORT_TOKEN bytes are copied by a fixed size copy, if both the input
+ * and the output have room for it, as in \ref rleFillRun.
+ *
+ * \param[out]  out     Output position.
+ * \param[in]   room    Number of bytes available at \a out.
+ * \param[in]   data    Literal data.
+ * \param[in]   avail   Number of bytes readable at \a data.
+ * \param[in]   count   Length of literal data, at most \a room and \a avail.
+ */
+static inline void rleCopyLiteral(uint8_t *out, uint32_t room,
+                                  const uint8_t *data, uint32_t avail,
+                                  uint32_t count) {
+  if (count > SHORT_TOKEN || room < SHORT_TOKEN || avail < SHORT_TOKEN) {
+    memcpy(out, data, count);
+    return;
+  }
+
+  memcpy(out, data, SHORT_TOKEN);
+}
+
+/*! Reads the token at \a pos and moves \a pos behind it. The caller must check
+ * that \a pos is lower than \a len. Stored blocks are read as literal blocks.
+ *
+ * \param[in]     in      Encoded input array.
+ * \param[in]     len     Length of input array.
+ * \param[in,out] pos     Position of the token header.
+ * \param[out]    token   Read token.
+ *
+ * \return \ref RLE_ERROR for malformed token, \ref RLE_OK otherwise.
+ */
+static inline RLE_State rleReadToken(const uint8_t *in, uint32_t len,
+                                     uint32_t *pos, RleToken *token) {
+  uint8_t header = in[(*pos)++];
+  uint32_t payload;
+
+  token->count = header & MAX_COUNT;
+  token->literal = (header & LITERAL_FLAG) != 0;
+
+  if (header == STORED_HEADER && len - *pos >= 2) {
+    token->count = in[*pos] | (uint32_t)in[*pos + 1] << 8;
+    *pos += 2;
+  }
+
+  token->data = &in[*pos];
+  payload = token->literal ? token->count : 1;
+
+  if (token->count == 0 || len - *pos < payload) {
+    return RLE_ERROR;
+  }
+
+  *pos += payload;
+  return RLE_OK;
+}
+
+#endif  // RLE_PRIVATE_H
@@ -0,0 +1,394 @@
+/*!
+ * \file    rle_query.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of queries evaluated directly on RLE encoded data.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_query.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! Position in encoded data used to walk two streams in lockstep. */
+typedef struct {
+  const uint8_t *in; /*!< Encoded data. */
+  uint32_t len;      /*!< Length of encoded data. */
+  uint32_t pos;      /*!< Position of the next token. */
+  RleToken token;    /*!< Current token. */
+  uint32_t used;     /*!< Already compared bytes of current token. */
+} Cursor;
+
+/*! Growing list of differing ranges. */
+typedef struct {
+  RLE_Range *ranges; /*!< Heap allocated ranges. */
+  uint32_t count;    /*!< Number of stored ranges. */
+  uint32_t capacity; /*!< Number of allocated ranges. */
+} RangeList;
+
+/* Private macros ------------------------------------------------------------*/
+/*! Initial capacity of the list of differing ranges. */
+#define RANGES_INITIAL (16)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static RLE_State compareStreams(const uint8_t *first, uint32_t firstLen,
+                                const uint8_t *second, uint32_t secondLen,
+                                RangeList *list, uint64_t *difference);
+static RLE_State cursorFill(Cursor *cursor, bool *filled);
+static uint8_t cursorByte(const Cursor *cursor, uint32_t index);
+static bool addRange(RangeList *list, uint64_t offset, uint64_t length);
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_count(const uint8_t *in, uint32_t len, uint8_t value,
+                    uint64_t *count) {
+  if (in == NULL || len == 0 || count == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t total = 0;
+  uint32_t i = 0;
+
+  while (i < len) {
+    RleToken token;
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+
+    if (!token.literal) {
+      total += token.data[0] == value ? token.count : 0;
+    } else {
+      for (uint32_t j = 0; j < token.count; j++) {
+        total += token.data[j] == value;
+      }
+    }
+  }
+
+  *count = total;
+  return RLE_OK;
+}
+
+RLE_State RLE_sum(const uint8_t *in, uint32_t len, uint64_t *sum) {
+  if (in == NULL || len == 0 || sum == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t total = 0;
+  uint32_t i = 0;
+
+  while (i < len) {
+    RleToken token;
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+
+    if (!token.literal) {
+      total += (uint64_t)token.data[0] * token.count;
+    } else {
+      for (uint32_t j = 0; j < token.count; j++) {
+        total += token.data[j];
+      }
+    }
+  }
+
+  *sum = total;
+  return RLE_OK;
+}
+
+RLE_State RLE_histogram(const uint8_t *in, uint32_t len,
+                        uint64_t histogram[256]) {
+  if (in == NULL || len == 0 || histogram == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t counts[256] = {0};
+  uint32_t i = 0;
+
+  while (i < len) {
+    RleToken token;
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+
+    if (!token.literal) {
+      counts[token.data[0]] += token.count;
+    } else {
+      for (uint32_t j = 0; j < token.count; j++) {
+        counts[token.data[j]]++;
+      }
+    }
+  }
+
+  memcpy(histogram, counts, sizeof(counts));
+  return RLE_OK;
+}
+
+RLE_State RLE_find(const uint8_t *in, uint32_t len, uint8_t value,
+                   uint64_t *position) {
+  if (in == NULL || len == 0 || position == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t offset = 0;
+  uint32_t i = 0;
+
+  while (i < len) {
+    RleToken token;
+    if (rleReadToken(in, len, &i, &token) != RLE_OK) {
+      return RLE_ERROR;
+    }
+
+    if (!token.literal) {
+      if (token.data[0] == value) {
+        *position = offset;
+        return RLE_OK;
+      }
+    } else {
+      const uint8_t *match = memchr(token.data, value, token.count);
+      if (match != NULL) {
+        *position = offset + (uint64_t)(match - token.data);
+        return RLE_OK;
+      }
+    }
+    offset += token.count;
+  }
+
+  *position = offset;
+  return RLE_OK;
+}
+
+RLE_State RLE_equal(const uint8_t *first, uint32_t firstLen,
+                    const uint8_t *second, uint32_t secondLen, bool *equal) {
+  if (equal == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint64_t difference;
+  RLE_State state =
+      compareStreams(first, firstLen, second, secondLen, NULL, &difference);
+  if (state == RLE_OK) {
+    *equal = difference == UINT64_MAX;
+  }
+
+  return state;
+}
+
+RLE_State RLE_first_difference(const uint8_t *first, uint32_t firstLen,
+                               const uint8_t *second, uint32_t secondLen,
+                               uint64_t *offset) {
+  if (offset == NULL) {
+    return RLE_ERROR;
+  }
+
+  return compareStreams(first, firstLen, second, secondLen, NULL, offset);
+}
+
+RLE_State RLE_diff(const uint8_t *first, uint32_t firstLen,
+                   const uint8_t *second, uint32_t secondLen,
+                   RLE_Range **ranges, uint32_t *count) {
+  if (ranges == NULL || count == NULL) {
+    return RLE_ERROR;
+  }
+
+  RangeList list = {NULL, 0, 0};
+  uint64_t difference;
+  RLE_State state =
+      compareStreams(first, firstLen, second, secondLen, &list, &difference);
+
+  if (state != RLE_OK) {
+    free(list.ranges);
+    return state;
+  }
+
+  *ranges = list.ranges;
+  *count = list.count;
+  return RLE_OK;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Walks two encoded streams in lockstep and compares their decoded data. The
+ * tokens are validated while walked, so each stream is read once. The walk
+ * stops at the first difference if \a list is NULL, including the end of the
+ * shorter stream, and the tokens behind it are not validated. Otherwise all
+ * differing ranges are stored to \a list and the tail of the longer stream is
+ * walked to find its size.
+ *
+ * \param[in]   first       First encoded array.
+ * \param[in]   firstLen    Length of the first array.
+ * \param[in]   second      Second encoded array.
+ * \param[in]   secondLen   Length of the second array.
+ * \param[out]  list        List of differing ranges, may be NULL.
+ * \param[out]  difference  Offset of the first difference, UINT64_MAX if the
+ * decoded data are equal.
+ *
+ * \return If error occure the \ref RLE_ERROR is returned, \ref RLE_OK
+ * otherwise.
+ */
+static RLE_State compareStreams(const uint8_t *first, uint32_t firstLen,
+                                const uint8_t *second, uint32_t secondLen,
+                                RangeList *list, uint64_t *difference) {
+  if (first == NULL || firstLen == 0 || second == NULL || secondLen == 0) {
+    return RLE_ERROR;
+  }
+
+  Cursor a = {first, firstLen, 0, {NULL, 0, false}, 0};
+  Cursor b = {second, secondLen, 0, {NULL, 0, false}, 0};
+  uint64_t offset = 0;
+  bool moreA;
+  bool moreB;
+
+  *difference = UINT64_MAX;
+  for (;;) {
+    if (cursorFill(&a, &moreA) != RLE_OK ||
+        cursorFill(&b, &moreB) != RLE_OK) {
+      return RLE_ERROR;
+    }
+    if (!moreA || !moreB) {
+      break;
+    }
+
+    uint32_t left = a.token.count - a.used;
+    uint32_t step = b.token.count - b.used;
+    step = left < step ? left : step;
+
+    if (!a.token.literal && !b.token.literal) {
+      // two runs differ either completely or not at all
+      if (a.token.data[0] != b.token.data[0]) {
+        if (*difference == UINT64_MAX) {
+          *difference = offset;
+        }
+        if (list == NULL) {
+          return RLE_OK;
+        }
+        if (!addRange(list, offset, step)) {
+          return RLE_ERROR;
+        }
+      }
+    } else {
+      for (uint32_t i = 0; i < step; i++) {
+        if (cursorByte(&a, i) != cursorByte(&b, i)) {
+          if (*difference == UINT64_MAX) {
+            *difference = offset + i;
+          }
+          if (list == NULL) {
+            return RLE_OK;
+          }
+          if (!addRange(list, offset + i, 1)) {
+            return RLE_ERROR;
+          }
+        }
+      }
+    }
+
+    a.used += step;
+    b.used += step;
+    offset += step;
+  }
+
+  if (moreA == moreB) {
+    return RLE_OK;
+  }
+
+  // decoded sizes differ, the shorter data end at the offset
+  if (*difference == UINT64_MAX) {
+    *difference = offset;
+  }
+  if (list == NULL) {
+    return RLE_OK;
+  }
+
+  const Cursor *longer = moreA ? &a : &b;
+  uint64_t tail = 0;
+  if (rleScanDecodedSize(&longer->in[longer->pos], longer->len - longer->pos,
+                         UINT64_MAX, &tail) != RLE_OK ||
+      !addRange(list, offset,
+                tail + longer->token.count - longer->used)) {
+    return RLE_ERROR;
+  }
+
+  return RLE_OK;
+}
+
+/*! Moves the cursor to the next token if the current one is fully compared.
+ * The next token is validated when read.
+ *
+ * \param[in,out] cursor  Cursor to move.
+ * \param[out]    filled  False at the end of data, true otherwise.
+ *
+ * \return If the next token is malformed the \ref RLE_ERROR is returned,
+ * \ref RLE_OK otherwise.
+ */
+static RLE_State cursorFill(Cursor *cursor, bool *filled) {
+  while (cursor->used == cursor->token.count) {
+    if (cursor->pos >= cursor->len) {
+      *filled = false;
+      return RLE_OK;
+    }
+    if (rleReadToken(cursor->in, cursor->len, &cursor->pos, &cursor->token) !=
+        RLE_OK) {
+      return RLE_ERROR;
+    }
+    cursor->used = 0;
+  }
+
+  *filled = true;
+  return RLE_OK;
+}
+
+/*! Returns decoded byte \a index bytes ahead of the cursor within the current
+ * token.
+ *
+ * \param[in]   cursor  Cursor in encoded data.
+ * \param[in]   index   Offset from the cursor.
+ *
+ * \return Decoded byte.
+ */
+static uint8_t cursorByte(const Cursor *cursor, uint32_t index) {
+  return cursor->token.literal ? cursor->token.data[cursor->used + index]
+                               : cursor->token.data[0];
+}
+
+/*! Adds a differing range to the list. The range is merged with the last one
+ * if they are adjacent.
+ *
+ * \param[in,out] list    List of ranges.
+ * \param[in]     offset  Offset of the range.
+ * \param[in]     length  Length of the range.
+ *
+ * \return Returns false if the list cannot grow, true otherwise.
+ */
+static bool addRange(RangeList *list, uint64_t offset, uint64_t length) {
+  if (list->count > 0) {
+    RLE_Range *last = &list->ranges[list->count - 1];
+    if (last->offset + last->length == offset) {
+      last->length += length;
+      return true;
+    }
+  }
+
+  if (list->count == list->capacity) {
+    uint32_t capacity = list->capacity ? 2 * list->capacity : RANGES_INITIAL;
+    RLE_Range *p = realloc(list->ranges, capacity * sizeof(RLE_Range));
+    if (p == NULL) {
+      return false;
+    }
+    list->ranges = p;
+    list->capacity = capacity;
+  }
+
+  list->ranges[list->count].offset = offset;
+  list->ranges[list->count].length = length;
+  list->count++;
+
+  return true;
+}
@@ -0,0 +1,251 @@
+/*!
+ * \file    rle_stream.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of resumable RLE encoder and decoder.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_stream.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+#if RLE_ENCODER_CARRY_SIZE < 2 * ENCODE_CARRY_MAX
+#error "RLE_ENCODER_CARRY_SIZE must hold two undecided tokens"
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+/* Exported functions definitions --------------------------------------------*/
+void RLE_encoder_init(RLE_Encoder *encoder) {
+  encoder->carryLen = 0;
+}
+
+uint64_t RLE_encoder_bound(uint32_t len) {
+  return rleEncodeBound((uint64_t)len + ENCODE_CARRY_MAX);
+}
+
+RLE_State RLE_encoder_feed(RLE_Encoder *encoder, const uint8_t *in,
+                           uint32_t len, uint8_t *out, uint32_t *outLen) {
+  if (encoder == NULL || (in == NULL && len != 0) || out == NULL ||
+      outLen == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t written = 0;
+  uint32_t pos = 0;
+  uint32_t consumed;
+
+  if (encoder->carryLen > 0) {
+    // Complete the kept token from the head of new data. The carry holds two
+    // undecided tokens, so either the kept bytes get encoded or all new data
+    // fit to the carry.
+    uint32_t kept = encoder->carryLen;
+    uint32_t taken = RLE_ENCODER_CARRY_SIZE - kept;
+    if (taken > len) {
+      taken = len;
+    }
+    memcpy(&encoder->carry[kept], in, taken);
+
+    written = rleEncodeTokens(encoder->carry, kept + taken, out, false,
+                              &consumed);
+    if (consumed < kept) {
+      encoder->carryLen = kept + taken - consumed;
+      memmove(encoder->carry, &encoder->carry[consumed], encoder->carryLen);
+      *outLen = written;
+      return RLE_OK;
+    }
+    pos = consumed - kept;
+  }
+
+  written += rleEncodeTokens(&in[pos], len - pos, &out[written], false,
+                             &consumed);
+  pos += consumed;
+
+  encoder->carryLen = len - pos;
+  if (encoder->carryLen > 0) {
+    memcpy(encoder->carry, &in[pos], encoder->carryLen);
+  }
+  *outLen = written;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_encoder_finish(RLE_Encoder *encoder, uint8_t *out,
+                             uint32_t *outLen) {
+  if (encoder == NULL || out == NULL || outLen == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint32_t consumed;
+  *outLen = rleEncodeTokens(encoder->carry, encoder->carryLen, out, true,
+                            &consumed);
+  encoder->carryLen = 0;
+
+  return RLE_OK;
+}
+
+void RLE_decoder_init(RLE_Decoder *decoder) {
+  decoder->remaining = 0;
+  decoder->value = 0;
+  decoder->lengthBytes = 0;
+  decoder->literal = false;
+  decoder->needValue = false;
+}
+
+RLE_State RLE_decoder_feed(RLE_Decoder *decoder, const uint8_t **in,
+                           uint32_t *inLen, uint8_t *out, uint32_t outSize,
+                           uint32_t *outLen) {
+  if (decoder == NULL || in == NULL || inLen == NULL ||
+      (*in == NULL && *inLen != 0) || (out == NULL && outSize != 0) ||
+      outLen == NULL) {
+    return RLE_ERROR;
+  }
+
+  const uint8_t *i = *in;
+  uint32_t left = *inLen;
+  uint32_t produced = 0;
+  RLE_State state = RLE_OK;
+
+  while (produced < outSize) {
+    if (decoder->lengthBytes > 0) {
+      // Length of stored block, low byte first.
+      if (left == 0) {
+        break;
+      }
+      decoder->remaining |= (uint16_t)(*i++ << 8 * (2 - decoder->lengthBytes));
+      left--;
+      decoder->lengthBytes--;
+      if (decoder->lengthBytes == 0 && decoder->remaining == 0) {
+        state = RLE_ERROR;
+        break;
+      }
+      continue;
+    }
+
+    if (decoder->remaining == 0) {
+      if (left == 0) {
+        break;
+      }
+      uint8_t header = *i++;
+      left--;
+
+      decoder->remaining = header & MAX_COUNT;
+      decoder->literal = (header & LITERAL_FLAG) != 0;
+      decoder->needValue = !decoder->literal;
+      if (header == STORED_HEADER) {
+        decoder->lengthBytes = 2;
+        continue;
+      }
+      if (decoder->remaining == 0) {
+        state = RLE_ERROR;
+        break;
+      }
+    }
+
+    if (decoder->needValue) {
+      if (left == 0) {
+        break;
+      }
+      decoder->value = *i++;
+      left--;
+      decoder->needValue = false;
+    }
+
+    uint32_t n = decoder->remaining;
+    if (n > outSize - produced) {
+      n = outSize - produced;
+    }
+
+    if (decoder->literal) {
+      if (n > left) {
+        n = left;
+      }
+      if (n == 0) {
+        break;
+      }
+      memcpy(&out[produced], i, n);
+      i += n;
+      left -= n;
+    } else {
+      memset(&out[produced], decoder->value, n);
+    }
+
+    decoder->remaining -= (uint16_t)n;
+    produced += n;
+  }
+
+  *in = i;
+  *inLen = left;
+  *outLen = produced;
+
+  return state;
+}
+
+RLE_State RLE_decoder_finish(const RLE_Decoder *decoder) {
+  if (decoder == NULL || decoder->remaining != 0 ||
+      decoder->lengthBytes != 0) {
+    return RLE_ERROR;
+  }
+
+  return RLE_OK;
+}
+
+RLE_State RLE_decode_cb(const uint8_t *in, uint32_t len, uint8_t *tile,
+                        uint32_t tileSize, RLE_Consumer consumer,
+                        void *context, uint64_t *decoded) {
+  if (in == NULL || len == 0 || (tile != NULL && tileSize == 0) ||
+      consumer == NULL) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *allocated = NULL;
+  if (tile == NULL) {
+    allocated = malloc(RLE_DECODE_TILE_SIZE);
+    if (allocated == NULL) {
+      return RLE_ERROR;
+    }
+    tile = allocated;
+    tileSize = RLE_DECODE_TILE_SIZE;
+  }
+
+  RLE_Decoder decoder;
+  RLE_State state;
+  uint64_t total = 0;
+  uint32_t produced;
+  bool stopped = false;
+
+  RLE_decoder_init(&decoder);
+  do {
+    state = RLE_decoder_feed(&decoder, &in, &len, tile, tileSize, &produced);
+    if (state == RLE_OK && produced > 0) {
+      total += produced;
+      stopped = !consumer(context, tile, produced);
+    }
+  } while (state == RLE_OK && !stopped && produced == tileSize);
+
+  if (state == RLE_OK && !stopped) {
+    state = RLE_decoder_finish(&decoder);
+  }
+  free(allocated);
+
+  if (decoded != NULL) {
+    *decoded = total;
+  }
+
+  return state;
+}
+
+/* Private function definitions ----------------------------------------------*/
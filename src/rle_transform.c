@@ -0,0 +1,607 @@
+/*!
+ * \file    rle_transform.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of RLE coding with reversible pre-transforms.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rle_transform.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rle_private.h"
+#include "rle_stream.h"
+
+/* Private types -------------------------------------------------------------*/
+/*! State of one pipeline stage carried between tiles. */
+typedef struct {
+  uint64_t prev;      /*!< Previous element. */
+  uint64_t prevDelta; /*!< Previous difference, used by the second order. */
+  uint8_t table[256]; /*!< Move-to-front table. */
+} StageState;
+
+/*! Transforms \a count elements of \a data in place. */
+typedef void (*ElementKernel)(uint8_t *data, uint32_t count, uint8_t order,
+                              StageState *state);
+
+/* Private macros ------------------------------------------------------------*/
+/*! Size of one transformed tile, it is a multiple of all element widths. */
+#define TILE_SIZE (RLE_TRANSFORM_TILE_SIZE)
+
+/*! Size of stored stage, i.e. type, width and order byte. */
+#define STAGE_SIZE (3)
+
+/*! Defines forward and inverse delta and XOR kernels for elements of \a TYPE.
+ * The fixed element size lets the compiler turn the byte loads and stores to
+ * single instructions.
+ */
+#define DEFINE_ELEMENT_KERNELS(TYPE, SUFFIX)                                  \
+  static void deltaForward##SUFFIX(uint8_t *data, uint32_t count,             \
+                                   uint8_t order, StageState *state) {        \
+    TYPE prev = (TYPE)state->prev;                                            \
+    TYPE prevDelta = (TYPE)state->prevDelta;                                  \
+    for (uint32_t k = 0; k < count; k++) {                                    \
+      TYPE x = (TYPE)loadLE(&data[k * sizeof(TYPE)], sizeof(TYPE));           \
+      TYPE d = (TYPE)(x - prev);                                              \
+      prev = x;                                                               \
+      if (order == 2) {                                                       \
+        TYPE dd = (TYPE)(d - prevDelta);                                      \
+        prevDelta = d;                                                        \
+        d = dd;                                                               \
+      }                                                                       \
+      storeLE(&data[k * sizeof(TYPE)], d, sizeof(TYPE));                      \
+    }                                                                         \
+    state->prev = prev;                                                       \
+    state->prevDelta = prevDelta;                                             \
+  }                                                                           \
+                                                                              \
+  static void deltaInverse##SUFFIX(uint8_t *data, uint32_t count,             \
+                                   uint8_t order, StageState *state) {        \
+    TYPE prev = (TYPE)state->prev;                                            \
+    TYPE prevDelta = (TYPE)state->prevDelta;                                  \
+    for (uint32_t k = 0; k < count; k++) {                                    \
+      TYPE d = (TYPE)loadLE(&data[k * sizeof(TYPE)], sizeof(TYPE));           \
+      if (order == 2) {                                                       \
+        d = (TYPE)(d + prevDelta);                                            \
+        prevDelta = d;                                                        \
+      }                                                                       \
+      prev = (TYPE)(prev + d);                                                \
+      storeLE(&data[k * sizeof(TYPE)], prev, sizeof(TYPE));                   \
+    }                                                                         \
+    state->prev = prev;                                                       \
+    state->prevDelta = prevDelta;                                             \
+  }                                                                           \
+                                                                              \
+  static void xorForward##SUFFIX(uint8_t *data, uint32_t count,               \
+                                 uint8_t order, StageState *state) {          \
+    TYPE prev = (TYPE)state->prev;                                            \
+    (void)order;                                                              \
+    for (uint32_t k = 0; k < count; k++) {                                    \
+      TYPE x = (TYPE)loadLE(&data[k * sizeof(TYPE)], sizeof(TYPE));           \
+      storeLE(&data[k * sizeof(TYPE)], x ^ prev, sizeof(TYPE));               \
+      prev = x;                                                               \
+    }                                                                         \
+    state->prev = prev;                                                       \
+  }                                                                           \
+                                                                              \
+  static void xorInverse##SUFFIX(uint8_t *data, uint32_t count,               \
+                                 uint8_t order, StageState *state) {          \
+    TYPE prev = (TYPE)state->prev;                                            \
+    (void)order;                                                              \
+    for (uint32_t k = 0; k < count; k++) {                                    \
+      prev ^= (TYPE)loadLE(&data[k * sizeof(TYPE)], sizeof(TYPE));            \
+      storeLE(&data[k * sizeof(TYPE)], prev, sizeof(TYPE));                   \
+    }                                                                         \
+    state->prev = prev;                                                       \
+  }
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static inline uint64_t loadLE(const uint8_t *in, uint32_t size);
+static inline void storeLE(uint8_t *out, uint64_t value, uint32_t size);
+static int widthIndex(uint8_t width);
+static bool validStage(const RLE_Stage *stage);
+static bool validPipeline(const RLE_Pipeline *pipeline);
+static void initStates(StageState *states, uint8_t count);
+static void applyStage(const RLE_Stage *stage, bool inverse, uint8_t *data,
+                       uint32_t n, uint8_t *scratch, StageState *state);
+static void shuffle(uint8_t *data, uint32_t count, uint8_t width,
+                    bool inverse, uint8_t *scratch);
+static void moveToFront(uint8_t *data, uint32_t n, bool inverse,
+                        uint8_t *table);
+static uint32_t encodeTiles(const uint8_t *in, uint32_t len,
+                            const RLE_Stage *stages, uint8_t count,
+                            uint8_t *out);
+static void decodeTiles(const uint8_t *in, uint32_t len,
+                        const RLE_Stage *stages, uint8_t count, uint8_t *out,
+                        uint32_t size);
+static RLE_State allocEncoded(uint32_t len, uint32_t header, uint8_t **data);
+static RLE_State allocDecoded(const uint8_t *in, uint32_t len, uint8_t **data,
+                              uint32_t *size);
+
+DEFINE_ELEMENT_KERNELS(uint8_t, 8)
+DEFINE_ELEMENT_KERNELS(uint16_t, 16)
+DEFINE_ELEMENT_KERNELS(uint32_t, 32)
+DEFINE_ELEMENT_KERNELS(uint64_t, 64)
+
+/*! Delta kernels indexed by direction and binary logarithm of width. */
+static const ElementKernel deltaKernels[2][4] = {
+    {deltaForward8, deltaForward16, deltaForward32, deltaForward64},
+    {deltaInverse8, deltaInverse16, deltaInverse32, deltaInverse64},
+};
+
+/*! XOR kernels indexed by direction and binary logarithm of width. */
+static const ElementKernel xorKernels[2][4] = {
+    {xorForward8, xorForward16, xorForward32, xorForward64},
+    {xorInverse8, xorInverse16, xorInverse32, xorInverse64},
+};
+
+/* Exported functions definitions --------------------------------------------*/
+RLE_State RLE_encode_delta(const uint8_t *in, uint32_t len,
+                           const RLE_DeltaOptions *options, RLE_Data *result) {
+  if (in == NULL || len == 0 || options == NULL || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  RLE_Stage stage = {RLE_STAGE_DELTA, options->width, options->order};
+  if (!validStage(&stage)) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data;
+  if (allocEncoded(len, 0, &data) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  uint32_t size = encodeTiles(in, len, &stage, 1, data);
+  uint8_t *p = realloc(data, size);
+
+  result->data = p != NULL ? p : data;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_decode_delta(const uint8_t *in, uint32_t len,
+                           const RLE_DeltaOptions *options, RLE_Data *result) {
+  if (in == NULL || len == 0 || options == NULL || result == NULL) {
+    return RLE_ERROR;
+  }
+
+  RLE_Stage stage = {RLE_STAGE_DELTA, options->width, options->order};
+  if (!validStage(&stage)) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data;
+  uint32_t size;
+  RLE_State state = allocDecoded(in, len, &data, &size);
+  if (state != RLE_OK) {
+    return state;
+  }
+
+  decodeTiles(in, len, &stage, 1, data, size);
+  result->data = data;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_encode_pipeline(const uint8_t *in, uint32_t len,
+                              const RLE_Pipeline *pipeline, RLE_Data *result) {
+  if (in == NULL || len == 0 || result == NULL || !validPipeline(pipeline)) {
+    return RLE_ERROR;
+  }
+
+  uint32_t header = 1 + pipeline->count * STAGE_SIZE;
+  uint8_t *data;
+  if (allocEncoded(len, header, &data) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  data[0] = pipeline->count;
+  for (uint8_t s = 0; s < pipeline->count; s++) {
+    data[1 + s * STAGE_SIZE] = pipeline->stages[s].type;
+    data[2 + s * STAGE_SIZE] = pipeline->stages[s].width;
+    data[3 + s * STAGE_SIZE] = pipeline->stages[s].order;
+  }
+
+  uint32_t size = header + encodeTiles(in, len, pipeline->stages,
+                                       pipeline->count, &data[header]);
+  uint8_t *p = realloc(data, size);
+
+  result->data = p != NULL ? p : data;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_decode_pipeline(const uint8_t *in, uint32_t len,
+                              RLE_Data *result) {
+  RLE_Pipeline pipeline;
+
+  if (result == NULL || RLE_pipeline_read(in, len, &pipeline) != RLE_OK) {
+    return RLE_ERROR;
+  }
+
+  uint32_t header = 1 + pipeline.count * STAGE_SIZE;
+  if (len == header) {
+    return RLE_ERROR;
+  }
+
+  uint8_t *data;
+  uint32_t size;
+  RLE_State state = allocDecoded(&in[header], len - header, &data, &size);
+  if (state != RLE_OK) {
+    return state;
+  }
+
+  decodeTiles(&in[header], len - header, pipeline.stages, pipeline.count,
+              data, size);
+  result->data = data;
+  result->size = size;
+
+  return RLE_OK;
+}
+
+RLE_State RLE_pipeline_read(const uint8_t *in, uint32_t len,
+                            RLE_Pipeline *pipeline) {
+  if (in == NULL || len == 0 || pipeline == NULL ||
+      in[0] > RLE_PIPELINE_MAX_STAGES ||
+      len < 1 + (uint32_t)in[0] * STAGE_SIZE) {
+    return RLE_ERROR;
+  }
+
+  RLE_Pipeline read;
+  read.count = in[0];
+  for (uint8_t s = 0; s < read.count; s++) {
+    read.stages[s].type = in[1 + s * STAGE_SIZE];
+    read.stages[s].width = in[2 + s * STAGE_SIZE];
+    read.stages[s].order = in[3 + s * STAGE_SIZE];
+  }
+
+  if (!validPipeline(&read)) {
+    return RLE_ERROR;
+  }
+
+  *pipeline = read;
+  return RLE_OK;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Loads little endian unsigned integer of \a size bytes.
+ *
+ * \param[in]   in      Input bytes.
+ * \param[in]   size    Number of bytes.
+ *
+ * \return Loaded value.
+ */
+static inline uint64_t loadLE(const uint8_t *in, uint32_t size) {
+  uint64_t value = 0;
+
+  for (uint32_t b = 0; b < size; b++) {
+    value |= (uint64_t)in[b] << (8 * b);
+  }
+
+  return value;
+}
+
+/*! Stores the low \a size bytes of \a value as little endian integer.
+ *
+ * \param[out]  out     Output bytes.
+ * \param[in]   value   Stored value.
+ * \param[in]   size    Number of bytes.
+ */
+static inline void storeLE(uint8_t *out, uint64_t value, uint32_t size) {
+  for (uint32_t b = 0; b < size; b++) {
+    out[b] = (uint8_t)(value >> (8 * b));
+  }
+}
+
+/*! Returns the binary logarithm of element width, or -1 if the width is not
+ * supported.
+ *
+ * \param[in]   width   Element width in bytes.
+ *
+ * \return Index of kernels for the width.
+ */
+static int widthIndex(uint8_t width) {
+  switch (width) {
+    case 1:
+      return 0;
+    case 2:
+      return 1;
+    case 4:
+      return 2;
+    case 8:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+/*! Checks type and parameters of pipeline \a stage.
+ *
+ * \param[in]   stage   Pipeline stage.
+ *
+ * \return Returns true if the stage is valid.
+ */
+static bool validStage(const RLE_Stage *stage) {
+  switch (stage->type) {
+    case RLE_STAGE_DELTA:
+      return widthIndex(stage->width) >= 0 &&
+             (stage->order == 1 || stage->order == 2);
+    case RLE_STAGE_SHUFFLE:
+    case RLE_STAGE_XOR:
+      return widthIndex(stage->width) >= 0;
+    case RLE_STAGE_MTF:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/*! Checks the number of stages and all stages of \a pipeline.
+ *
+ * \param[in]   pipeline  Transform pipeline, may be NULL.
+ *
+ * \return Returns true if the pipeline is valid.
+ */
+static bool validPipeline(const RLE_Pipeline *pipeline) {
+  if (pipeline == NULL || pipeline->count > RLE_PIPELINE_MAX_STAGES) {
+    return false;
+  }
+
+  for (uint8_t s = 0; s < pipeline->count; s++) {
+    if (!validStage(&pipeline->stages[s])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*! Initializes \a count stage states to the start of data.
+ *
+ * \param[out]  states  Stage states.
+ * \param[in]   count   Number of stages.
+ */
+static void initStates(StageState *states, uint8_t count) {
+  for (uint8_t s = 0; s < count; s++) {
+    states[s].prev = 0;
+    states[s].prevDelta = 0;
+    for (unsigned v = 0; v < 256; v++) {
+      states[s].table[v] = (uint8_t)v;
+    }
+  }
+}
+
+/*! Applies forward or inverse \a stage to \a n bytes of one tile in place.
+ * Trailing bytes, which do not form whole element, are not modified.
+ *
+ * \param[in]     stage     Pipeline stage.
+ * \param[in]     inverse   True to apply the inverse transform.
+ * \param[in,out] data      Tile data.
+ * \param[in]     n         Size of tile data.
+ * \param[out]    scratch   Scratch buffer of tile size.
+ * \param[in,out] state     State of the stage.
+ */
+static void applyStage(const RLE_Stage *stage, bool inverse, uint8_t *data,
+                       uint32_t n, uint8_t *scratch, StageState *state) {
+  switch (stage->type) {
+    case RLE_STAGE_SHUFFLE:
+      shuffle(data, n / stage->width, stage->width, inverse, scratch);
+      break;
+    case RLE_STAGE_DELTA:
+      deltaKernels[inverse][widthIndex(stage->width)](
+          data, n / stage->width, stage->order, state);
+      break;
+    case RLE_STAGE_XOR:
+      xorKernels[inverse][widthIndex(stage->width)](data, n / stage->width,
+                                                    stage->order, state);
+      break;
+    case RLE_STAGE_MTF:
+      moveToFront(data, n, inverse, state->table);
+      break;
+    default:
+      break;
+  }
+}
+
+/*! Transposes \a count elements of \a width bytes, so the first bytes of all
+ * elements are followed by the second bytes etc., or does the reverse.
+ *
+ * \param[in,out] data      Elements.
+ * \param[in]     count     Number of elements.
+ * \param[in]     width     Element width in bytes.
+ * \param[in]     inverse   True to restore the elements.
+ * \param[out]    scratch   Scratch buffer of \a count * \a width bytes.
+ */
+static void shuffle(uint8_t *data, uint32_t count, uint8_t width,
+                    bool inverse, uint8_t *scratch) {
+  for (uint32_t b = 0; b < width; b++) {
+    for (uint32_t k = 0; k < count; k++) {
+      if (inverse) {
+        scratch[k * width + b] = data[b * count + k];
+      } else {
+        scratch[b * count + k] = data[k * width + b];
+      }
+    }
+  }
+  memcpy(data, scratch, count * width);
+}
+
+/*! Replaces each byte by its index in the move-to-front \a table, or does the
+ * reverse, and moves the byte to the front of the table.
+ *
+ * \param[in,out] data      Bytes.
+ * \param[in]     n         Number of bytes.
+ * \param[in]     inverse   True to restore the bytes.
+ * \param[in,out] table     Move-to-front table.
+ */
+static void moveToFront(uint8_t *data, uint32_t n, bool inverse,
+                        uint8_t *table) {
+  for (uint32_t i = 0; i < n; i++) {
+    uint8_t index;
+    uint8_t value;
+
+    if (inverse) {
+      index = data[i];
+      value = table[index];
+    } else {
+      value = data[i];
+      index = 0;
+      while (table[index] != value) index++;
+    }
+
+    memmove(&table[1], table, index);
+    table[0] = value;
+    data[i] = inverse ? value : index;
+  }
+}
+
+/*! Transforms \a in array tile by tile through all \a stages and encodes the
+ * tiles by the resumable encoder.
+ *
+ * \param[in]   in      Input array.
+ * \param[in]   len     Length of input array.
+ * \param[in]   stages  Pipeline stages.
+ * \param[in]   count   Number of stages.
+ * \param[out]  out     Output buffer of \ref rleEncodeBound bytes.
+ *
+ * \return Number of bytes written to \a out.
+ */
+static uint32_t encodeTiles(const uint8_t *in, uint32_t len,
+                            const RLE_Stage *stages, uint8_t count,
+                            uint8_t *out) {
+  StageState states[RLE_PIPELINE_MAX_STAGES];
+  uint8_t tile[TILE_SIZE];
+  uint8_t scratch[TILE_SIZE];
+  RLE_Encoder encoder;
+  uint32_t size = 0;
+  uint32_t written;
+
+  initStates(states, count);
+  RLE_encoder_init(&encoder);
+
+  // The stream encoder output is identical to RLE_encode of whole transformed
+  // data, so every prefix of it fits to the bound.
+  for (uint32_t pos = 0; pos < len; pos += TILE_SIZE) {
+    uint32_t n = len - pos < TILE_SIZE ? len - pos : TILE_SIZE;
+
+    memcpy(tile, &in[pos], n);
+    for (uint8_t s = 0; s < count; s++) {
+      applyStage(&stages[s], false, tile, n, scratch, &states[s]);
+    }
+
+    RLE_encoder_feed(&encoder, tile, n, &out[size], &written);
+    size += written;
+  }
+  RLE_encoder_finish(&encoder, &out[size], &written);
+
+  return size + written;
+}
+
+/*! Decodes validated tokens by word fills of runs and copies of literals.
+ * The inverse \a stages are applied in the reverse order to each tile as
+ * soon as it is decoded, while it is still in cache.
+ *
+ * \param[in]   in      Encoded tokens.
+ * \param[in]   len     Length of encoded tokens.
+ * \param[in]   stages  Pipeline stages.
+ * \param[in]   count   Number of stages.
+ * \param[out]  out     Output buffer.
+ * \param[in]   size    Decoded size.
+ */
+static void decodeTiles(const uint8_t *in, uint32_t len,
+                        const RLE_Stage *stages, uint8_t count, uint8_t *out,
+                        uint32_t size) {
+  StageState states[RLE_PIPELINE_MAX_STAGES];
+  uint8_t scratch[TILE_SIZE];
+  uint32_t produced = 0;
+  uint32_t pos = 0;
+  uint32_t i = 0;
+
+  initStates(states, count);
+
+  while (pos < size) {
+    if (i < len) {
+      RleToken token;
+      rleReadToken(in, len, &i, &token);
+
+      // Short tokens may write a few bytes behind their end, which lie in
+      // the tiles not transformed yet.
+      uint32_t room = size - produced;
+      if (token.literal) {
+        uint32_t avail = (uint32_t)(&in[len] - token.data);
+        rleCopyLiteral(&out[produced], room, token.data, avail, token.count);
+      } else {
+        rleFillRun(&out[produced], room, token.data[0], token.count);
+      }
+      produced += token.count;
+    }
+
+    while (pos < size && (produced - pos >= TILE_SIZE || produced == size)) {
+      uint32_t n = size - pos < TILE_SIZE ? size - pos : TILE_SIZE;
+      for (uint8_t s = count; s-- > 0;) {
+        applyStage(&stages[s], true, &out[pos], n, scratch, &states[s]);
+      }
+      pos += n;
+    }
+  }
+}
+
+/*! Allocates output buffer for encoding \a len bytes with \a header.
+ *
+ * \param[in]   len     Length of input array.
+ * \param[in]   header  Size of header.
+ * \param[out]  data    Allocated buffer.
+ *
+ * \return If the size overflows or allocation fails the \ref RLE_ERROR is
+ * returned, \ref RLE_OK otherwise.
+ */
+static RLE_State allocEncoded(uint32_t len, uint32_t header, uint8_t **data) {
+  uint64_t bound = header + rleEncodeBound(len);
+  if (bound > UINT32_MAX) {
+    return RLE_ERROR;
+  }
+
+  *data = malloc(bound);
+  return *data != NULL ? RLE_OK : RLE_ERROR;
+}
+
+/*! Validates encoded tokens and allocates buffer for the decoded data.
+ *
+ * \param[in]   in      Encoded tokens.
+ * \param[in]   len     Length of encoded tokens.
+ * \param[out]  data    Allocated buffer.
+ * \param[out]  size    Decoded size.
+ *
+ * \return If the tokens are malformed or allocation fails the
+ * \ref RLE_ERROR is returned, \ref RLE_OK otherwise.
+ */
+static RLE_State allocDecoded(const uint8_t *in, uint32_t len, uint8_t **data,
+                              uint32_t *size) {
+  uint64_t total;
+  RLE_State state = rleScanDecodedSize(in, len, UINT32_MAX, &total);
+  if (state != RLE_OK) {
+    return state;
+  }
+
+  *data = malloc(total);
+  if (*data == NULL) {
+    return RLE_ERROR;
+  }
+
+  *size = (uint32_t)total;
+  return RLE_OK;
+}
@@ -11,6 +11,9 @@
  * Proprietary and confidential
  */
 /* Includes ------------------------------------------------------------------*/
+#include <cstring>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 extern "C" {
@@ -51,6 +54,7 @@ TEST(rle, decodeCorrectInputs) {
   RLE_Data data;
   uint8_t in[] = {0x81, 65};
   ASSERT_EQ(RLE_OK, RLE_decode(in, sizeof(in), &data));
+  free(data.data);
 }
 
 TEST(rle, decodeSimpleRepeat) {
@@ -112,6 +116,7 @@ TEST(rle, encodeCorrectInputs) {
   RLE_Data data;
   uint8_t in[] = {1, 65};
   ASSERT_EQ(RLE_OK, RLE_encode(in, 1, &data));
+  free(data.data);
 }
 
 TEST(rle, encodeLongRepetativeSequence) {
@@ -125,7 +130,7 @@ TEST(rle, encodeLongRepetativeSequence) {
   *pData++ = 66;
   *pData++ = 67;
 
-  uint8_t result[] = {1, 67, 255, 65, 5, 65, 1, 66, 1, 67};
+  uint8_t result[] = {0x81, 67, 127, 65, 127, 65, 6, 65, 0x82, 66, 67};
   RLE_encode(data, pData - data, &encoded);
 
   ASSERT_EQ(sizeof(result), encoded.size);
@@ -137,7 +142,7 @@ TEST(rle, encodeLongRepetativeSequence) {
 TEST(rle, encodeShortNonRepetativeSequence) {
   RLE_Data encoded = {NULL, 0};
   uint8_t data[] = {65, 66, 67};
-  uint8_t result[] = {1, 65, 1, 66, 1, 67};
+  uint8_t result[] = {0x83, 65, 66, 67};
 
   RLE_encode(data, sizeof(data), &encoded);
 
@@ -150,7 +155,7 @@ TEST(rle, encodeShortNonRepetativeSequence) {
 TEST(rle, encodeShortCombinedSequence) {
   RLE_Data encoded = {NULL, 0};
   uint8_t data[] = {65, 66, 67, 67, 67, 65, 65, 66};
-  uint8_t result[] = {1, 65, 1, 66, 3, 67, 2, 65, 1, 66};
+  uint8_t result[] = {0x82, 65, 66, 3, 67, 0x83, 65, 65, 66};
 
   RLE_encode(data, sizeof(data), &encoded);
 
@@ -163,7 +168,7 @@ TEST(rle, encodeShortCombinedSequence) {
 TEST(rle, encodeShortCombineMultipleSmallChunks) {
   RLE_Data encoded = {NULL, 0};
   uint8_t data[] = {65, 66, 67, 67, 67, 65, 65, 66, 66};
-  uint8_t result[] = {1, 65, 1, 66, 3, 67, 2, 65, 2, 66};
+  uint8_t result[] = {0x82, 65, 66, 3, 67, 2, 65, 2, 66};
 
   RLE_encode(data, sizeof(data), &encoded);
 
@@ -176,7 +181,7 @@ TEST(rle, encodeShortCombineMultipleSmallChunks) {
 TEST(rle, encodeUltraShortCombine) {
   RLE_Data encoded = {NULL, 0};
   uint8_t data[] = {65, 66, 66};
-  uint8_t result[] = {1, 65, 2, 66};
+  uint8_t result[] = {0x81, 65, 2, 66};
 
   RLE_encode(data, sizeof(data), &encoded);
 
@@ -188,7 +193,7 @@ TEST(rle, encodeUltraShortCombine) {
 TEST(rle, encodeSingleByte) {
   RLE_Data encoded = {NULL, 0};
   uint8_t data[] = {65};
-  uint8_t result[] = {1, 65};
+  uint8_t result[] = {0x81, 65};
 
   RLE_encode(data, sizeof(data), &encoded);
 
@@ -209,3 +214,271 @@ TEST(rle, testEncodeSingleSequence) {
   ASSERT_EQ(0, memcmp(encoded.data, result, sizeof(result)));
   free(encoded.data);
 }
+
+TEST(rle, encodeLiteralBlockSplit) {
+  RLE_Data encoded = {NULL, 0};
+  uint8_t data[130];
+  for (uint8_t i = 0; i < sizeof(data); ++i) {
+    data[i] = i;
+  }
+
+  RLE_encode(data, sizeof(data), &encoded);
+
+  ASSERT_EQ(sizeof(data) + 2, encoded.size);
+  ASSERT_EQ(0xff, encoded.data[0]);
+  ASSERT_EQ(0, memcmp(&encoded.data[1], data, 127));
+  ASSERT_EQ(0x83, encoded.data[128]);
+  ASSERT_EQ(0, memcmp(&encoded.data[129], &data[127], 3));
+  free(encoded.data);
+}
+
+TEST(rle, encodeWorstCaseExpansion) {
+  RLE_Data encoded = {NULL, 0};
+  RLE_Data decoded = {NULL, 0};
+  uint8_t data[999];
+  // one byte literal and a run of two bytes, e.g. A B B C D D ...
+  for (uint32_t i = 0; i < sizeof(data); i += 3) {
+    data[i] = (uint8_t)(2 * (i / 3));
+    data[i + 1] = data[i + 2] = (uint8_t)(2 * (i / 3) + 1);
+  }
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data, sizeof(data), &encoded));
+  ASSERT_LE(encoded.size, sizeof(data) + (sizeof(data) + 2) / 3);
+  ASSERT_EQ(RLE_OK, RLE_decode(encoded.data, encoded.size, &decoded));
+  ASSERT_EQ(sizeof(data), decoded.size);
+  ASSERT_EQ(0, memcmp(decoded.data, data, sizeof(data)));
+  free(encoded.data);
+  free(decoded.data);
+}
+
+TEST(rle, encodeStoredBlock) {
+  RLE_Data encoded = {NULL, 0};
+  uint8_t data[1000];
+  for (uint32_t i = 0; i < sizeof(data); ++i) {
+    data[i] = (uint8_t)(i * 7);
+  }
+
+  RLE_encode(data, sizeof(data), &encoded);
+
+  ASSERT_EQ(sizeof(data) + 3, encoded.size);
+  ASSERT_EQ(0x80, encoded.data[0]);
+  ASSERT_EQ(0xe8, encoded.data[1]);
+  ASSERT_EQ(0x03, encoded.data[2]);
+  ASSERT_EQ(0, memcmp(&encoded.data[3], data, sizeof(data)));
+  free(encoded.data);
+}
+
+TEST(rle, encodeIncompressibleBound) {
+  RLE_Data encoded = {NULL, 0};
+  RLE_Data decoded = {NULL, 0};
+  uint32_t len = 100000;
+  uint8_t *data = (uint8_t *)malloc(len);
+  uint32_t state = 12345;
+  for (uint32_t i = 0; i < len; ++i) {
+    state = state * 1103515245u + 12345u;
+    data[i] = (uint8_t)(state >> 24);
+  }
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data, len, &encoded));
+  ASSERT_GE(RLE_encode_bound(len), encoded.size);
+  ASSERT_GE(len + len / 1000, encoded.size);
+  ASSERT_EQ(RLE_OK, RLE_decode(encoded.data, encoded.size, &decoded));
+  ASSERT_EQ(len, decoded.size);
+  ASSERT_EQ(0, memcmp(decoded.data, data, len));
+
+  free(data);
+  free(encoded.data);
+  free(decoded.data);
+}
+
+TEST(rle, encodeWorstCaseBound) {
+  RLE_Data encoded = {NULL, 0};
+  uint8_t data[3000];
+  for (uint32_t i = 0; i < sizeof(data); ++i) {
+    data[i] = (uint8_t)(i % 130 < 127 ? i : 0);
+  }
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data, sizeof(data), &encoded));
+  ASSERT_GE(RLE_encode_bound(sizeof(data)), encoded.size);
+  free(encoded.data);
+}
+
+TEST(rle, encodeLiteralEndAtEachOffset) {
+  // the end of literal data and of the run falls on every offset of a word
+  for (uint32_t n = 1; n < 40; ++n) {
+    for (uint32_t run = 3; run < 20; ++run) {
+      std::vector<uint8_t> data;
+      for (uint32_t i = 0; i < n; ++i) {
+        data.push_back((uint8_t)(i + 1));
+      }
+      data.insert(data.end(), run, 0);
+      data.push_back(1);
+
+      std::vector<uint8_t> expected = {(uint8_t)(0x80 | n)};
+      expected.insert(expected.end(), data.begin(), data.begin() + n);
+      expected.insert(expected.end(), {(uint8_t)run, 0, 0x81, 1});
+
+      RLE_Data encoded = {NULL, 0};
+      ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+      ASSERT_EQ(expected, std::vector<uint8_t>(encoded.data,
+                                               encoded.data + encoded.size));
+      free(encoded.data);
+    }
+  }
+}
+
+TEST(rle, decodeStoredBlock) {
+  RLE_Data decoded = {NULL, 0};
+  uint8_t data[] = {0x80, 3, 0, 65, 66, 67, 2, 68};
+  uint8_t result[] = {65, 66, 67, 68, 68};
+
+  ASSERT_EQ(RLE_OK, RLE_decode(data, sizeof(data), &decoded));
+  ASSERT_EQ(sizeof(result), decoded.size);
+  ASSERT_EQ(0, memcmp(decoded.data, result, sizeof(result)));
+  free(decoded.data);
+}
+
+TEST(rle, decodeMalformedStoredBlocks) {
+  RLE_Data decoded = {NULL, 0};
+  uint8_t zeroLength[] = {0x80, 0, 0, 65};
+  uint8_t shortBlock[] = {0x80, 5, 0, 65, 66};
+  uint8_t shortLength[] = {2, 65, 0x80, 1};
+
+  ASSERT_EQ(RLE_ERROR, RLE_decode(zeroLength, sizeof(zeroLength), &decoded));
+  ASSERT_EQ(RLE_ERROR, RLE_decode(shortBlock, sizeof(shortBlock), &decoded));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_decode(shortLength, sizeof(shortLength), &decoded));
+}
+
+TEST(rle, encodeDecodeRoundTrip) {
+  RLE_Data encoded = {NULL, 0};
+  RLE_Data decoded = {NULL, 0};
+  uint8_t data[1000];
+  for (uint32_t i = 0; i < sizeof(data); ++i) {
+    data[i] = (uint8_t)((i * 7) / (1 + i % 13));
+  }
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data, sizeof(data), &encoded));
+  ASSERT_EQ(RLE_OK, RLE_decode(encoded.data, encoded.size, &decoded));
+
+  ASSERT_EQ(sizeof(data), decoded.size);
+  ASSERT_EQ(0, memcmp(decoded.data, data, sizeof(data)));
+  free(encoded.data);
+  free(decoded.data);
+}
+
+TEST(rle, decodeShortTokensNearEnd) {
+  // short tokens are stored by words unless they end near the output end
+  for (uint32_t tail = 1; tail < 40; ++tail) {
+    std::vector<uint8_t> data;
+    for (uint32_t i = 0; i < 20; ++i) {
+      data.insert(data.end(), i % 5 + 3, (uint8_t)i);
+      data.insert(data.end(), {200, (uint8_t)(201 + i % 3)});
+    }
+    for (uint32_t i = 0; i < tail; ++i) {
+      data.push_back((uint8_t)(tail % 2 == 0 ? 7 : i));
+    }
+
+    RLE_Data encoded = {NULL, 0};
+    RLE_Data decoded = {NULL, 0};
+    ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+    ASSERT_EQ(RLE_OK, RLE_decode(encoded.data, encoded.size, &decoded));
+    ASSERT_EQ(data, std::vector<uint8_t>(decoded.data,
+                                         decoded.data + decoded.size));
+    free(encoded.data);
+    free(decoded.data);
+  }
+}
+
+TEST(rle, decodeMalformedTokens) {
+  RLE_Data decoded = {NULL, 0};
+  uint8_t zeroRun[] = {0, 65};
+  uint8_t zeroLiteral[] = {0x80, 65};
+  uint8_t shortLiteral[] = {0x83, 65, 66};
+
+  ASSERT_EQ(RLE_ERROR, RLE_decode(zeroRun, sizeof(zeroRun), &decoded));
+  ASSERT_EQ(RLE_ERROR, RLE_decode(zeroLiteral, sizeof(zeroLiteral), &decoded));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_decode(shortLiteral, sizeof(shortLiteral), &decoded));
+}
+
+TEST(rle, decodedSize) {
+  uint8_t data[] = {5, 65, 0x82, 66, 67, 127, 68};
+  uint32_t size = 0;
+
+  ASSERT_EQ(RLE_OK, RLE_decoded_size(data, sizeof(data), &size));
+  ASSERT_EQ(134u, size);
+}
+
+TEST(rle, decodedSizeMalformed) {
+  uint8_t truncated[] = {5, 65, 0x83, 66};
+  uint8_t zeroRun[] = {0, 65};
+  uint32_t size = 42;
+
+  ASSERT_EQ(RLE_ERROR, RLE_decoded_size(truncated, sizeof(truncated), &size));
+  ASSERT_EQ(42u, size);
+  ASSERT_EQ(RLE_ERROR, RLE_decoded_size(zeroRun, sizeof(zeroRun), &size));
+  ASSERT_EQ(42u, size);
+}
+
+TEST(rle, decodeMaxOutputSize) {
+  RLE_Data decoded = {NULL, 0};
+  uint8_t data[] = {127, 65, 127, 66};
+  RLE_DecodeOptions options = {200, 0};
+
+  ASSERT_EQ(RLE_ERROR_LIMIT,
+            RLE_decode_ex(data, sizeof(data), &options, &decoded));
+  ASSERT_EQ(NULL, decoded.data);
+
+  options.maxOutputSize = 254;
+  ASSERT_EQ(RLE_OK, RLE_decode_ex(data, sizeof(data), &options, &decoded));
+  ASSERT_EQ(254u, decoded.size);
+  free(decoded.data);
+}
+
+TEST(rle, decodeMaxRatio) {
+  RLE_Data decoded = {NULL, 0};
+  uint8_t data[] = {127, 65, 0x81, 66};
+  RLE_DecodeOptions options = {0, 16};
+
+  ASSERT_EQ(RLE_ERROR_LIMIT,
+            RLE_decode_ex(data, sizeof(data), &options, &decoded));
+
+  options.maxRatio = 32;
+  ASSERT_EQ(RLE_OK, RLE_decode_ex(data, sizeof(data), &options, &decoded));
+  ASSERT_EQ(128u, decoded.size);
+  free(decoded.data);
+}
+
+TEST(rle, encodeInto) {
+  uint8_t data[] = {65, 65, 65, 65, 66, 67, 67, 67};
+  uint8_t expected[] = {4, 65, 0x81, 66, 3, 67};
+  uint8_t out[sizeof(data) + 2];
+  uint32_t written = 0;
+
+  ASSERT_EQ(RLE_ERROR, RLE_encode_into(data, sizeof(data), out,
+                                       RLE_encode_bound(sizeof(data)) - 1,
+                                       &written));
+  ASSERT_EQ(RLE_OK,
+            RLE_encode_into(data, sizeof(data), out, sizeof(out), &written));
+  ASSERT_EQ(sizeof(expected), written);
+  ASSERT_EQ(0, memcmp(expected, out, written));
+}
+
+TEST(rle, decodeInto) {
+  uint8_t data[] = {5, 65, 0x82, 66, 67};
+  uint8_t expected[] = {65, 65, 65, 65, 65, 66, 67};
+  uint8_t out[sizeof(expected) + 1] = {0};
+  uint8_t malformed[] = {5, 65, 0x83, 66};
+  uint32_t written = 0;
+
+  ASSERT_EQ(RLE_ERROR_LIMIT, RLE_decode_into(data, sizeof(data), out,
+                                             sizeof(expected) - 1, &written));
+  ASSERT_EQ(0, out[0]);
+  ASSERT_EQ(RLE_ERROR, RLE_decode_into(malformed, sizeof(malformed), out,
+                                       sizeof(out), &written));
+  ASSERT_EQ(RLE_OK,
+            RLE_decode_into(data, sizeof(data), out, sizeof(out), &written));
+  ASSERT_EQ(sizeof(expected), written);
+  ASSERT_EQ(0, memcmp(expected, out, written));
+}
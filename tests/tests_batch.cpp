@@ -0,0 +1,139 @@
+/*!
+ * \file    tests_batch.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of batch RLE coding.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_batch.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<std::vector<uint8_t>> samplePayloads(size_t count);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<std::vector<uint8_t>> samplePayloads(size_t count) {
+  std::vector<std::vector<uint8_t>> payloads;
+  srand(3);
+  for (size_t k = 0; k < count; ++k) {
+    std::vector<uint8_t> payload;
+    size_t size = k % 10 == 0 ? 0 : rand() % 500 + 1;
+    while (payload.size() < size) {
+      uint8_t value = (uint8_t)(rand() % 4);
+      payload.insert(payload.end(), rand() % 8 + 1, value);
+    }
+    payload.resize(size);
+    payloads.push_back(payload);
+  }
+  return payloads;
+}
+
+TEST(rleBatch, wrongInputs) {
+  RLE_Data result = {NULL, 0};
+  uint32_t offsets[2];
+  RLE_Span span = {NULL, 1};
+  uint8_t malformed[] = {3, 65, 0x82, 66};
+  RLE_Span truncated = {malformed, sizeof(malformed)};
+
+  ASSERT_EQ(RLE_ERROR, RLE_encode_batch(NULL, 1, &result, offsets));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_batch(&span, 0, &result, offsets));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_batch(&span, 1, &result, offsets));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_batch(&span, 1, &result, offsets));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_batch(&truncated, 1, &result, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_batch(&truncated, 1, &result, offsets));
+  ASSERT_EQ(NULL, result.data);
+}
+
+TEST(rleBatch, encodeMatchesEncode) {
+  std::vector<std::vector<uint8_t>> payloads = samplePayloads(1000);
+  std::vector<RLE_Span> spans;
+  for (const auto &payload : payloads) {
+    spans.push_back({payload.data(), (uint32_t)payload.size()});
+  }
+  std::vector<uint32_t> offsets(spans.size() + 1);
+  RLE_Data arena = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_encode_batch(spans.data(), spans.size(), &arena,
+                                     offsets.data()));
+  ASSERT_EQ(0u, offsets[0]);
+  ASSERT_EQ(arena.size, offsets[spans.size()]);
+
+  for (size_t k = 0; k < payloads.size(); ++k) {
+    std::vector<uint8_t> encoded(arena.data + offsets[k],
+                                 arena.data + offsets[k + 1]);
+    if (payloads[k].empty()) {
+      ASSERT_TRUE(encoded.empty());
+      continue;
+    }
+    RLE_Data expected = {NULL, 0};
+    ASSERT_EQ(RLE_OK, RLE_encode(payloads[k].data(), payloads[k].size(),
+                                 &expected));
+    ASSERT_EQ(std::vector<uint8_t>(expected.data,
+                                   expected.data + expected.size),
+              encoded)
+        << "payload " << k;
+    free(expected.data);
+  }
+  free(arena.data);
+}
+
+TEST(rleBatch, roundTrip) {
+  std::vector<std::vector<uint8_t>> payloads = samplePayloads(777);
+  std::vector<RLE_Span> spans;
+  for (const auto &payload : payloads) {
+    spans.push_back({payload.data(), (uint32_t)payload.size()});
+  }
+  std::vector<uint32_t> offsets(spans.size() + 1);
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode_batch(spans.data(), spans.size(), &encoded,
+                                     offsets.data()));
+
+  std::vector<RLE_Span> encodedSpans;
+  for (size_t k = 0; k < spans.size(); ++k) {
+    encodedSpans.push_back(
+        {encoded.data + offsets[k], offsets[k + 1] - offsets[k]});
+  }
+  RLE_Data decoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_decode_batch(encodedSpans.data(), encodedSpans.size(),
+                                     &decoded, offsets.data()));
+
+  for (size_t k = 0; k < payloads.size(); ++k) {
+    ASSERT_EQ(payloads[k], std::vector<uint8_t>(decoded.data + offsets[k],
+                                                decoded.data + offsets[k + 1]))
+        << "payload " << k;
+  }
+  free(encoded.data);
+  free(decoded.data);
+}
+
+TEST(rleBatch, emptyPayloads) {
+  RLE_Span spans[] = {{NULL, 0}, {NULL, 0}};
+  uint32_t offsets[3];
+  RLE_Data result = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_encode_batch(spans, 2, &result, offsets));
+  ASSERT_EQ(NULL, result.data);
+  ASSERT_EQ(0u, result.size);
+  ASSERT_EQ(0u, offsets[2]);
+  ASSERT_EQ(RLE_OK, RLE_decode_batch(spans, 2, &result, offsets));
+  ASSERT_EQ(NULL, result.data);
+  ASSERT_EQ(0u, result.size);
+  ASSERT_EQ(0u, offsets[1]);
+  ASSERT_EQ(0u, offsets[2]);
+}
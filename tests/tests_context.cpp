@@ -0,0 +1,146 @@
+/*!
+ * \file    tests_context.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of RLE coding with a reusable context.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tests_data.hpp"
+
+extern "C" {
+#include "rle.h"
+#include "rle_context.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+TEST(rleContext, wrongInputs) {
+  RLE_Context context;
+  RLE_Span result;
+  uint8_t data[] = {1, 65};
+
+  RLE_context_init(&context, NULL);
+  ASSERT_EQ(RLE_ERROR, RLE_context_encode(NULL, data, 2, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_context_encode(&context, data, 0, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_context_decode(&context, NULL, 2, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_context_decode(&context, data, 2, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_context_reserve(NULL, 10));
+  RLE_context_free(&context);
+}
+
+TEST(rleContext, matchesAllocatingCalls) {
+  RLE_Context context;
+  RLE_context_init(&context, NULL);
+
+  for (size_t size : {1u, 100u, 5000u, 100000u, 300u}) {
+    std::vector<uint8_t> data = sampleData(size, (unsigned)size);
+    RLE_Data expected = {NULL, 0};
+    RLE_Span encoded;
+    RLE_Span decoded;
+
+    ASSERT_EQ(RLE_OK, RLE_encode(data.data(), (uint32_t)size, &expected));
+    ASSERT_EQ(RLE_OK, RLE_context_encode(&context, data.data(),
+                                         (uint32_t)size, &encoded));
+    ASSERT_EQ(std::vector<uint8_t>(expected.data,
+                                   expected.data + expected.size),
+              std::vector<uint8_t>(encoded.data,
+                                   encoded.data + encoded.size));
+
+    ASSERT_EQ(RLE_OK, RLE_context_decode(&context, expected.data,
+                                         expected.size, &decoded));
+    ASSERT_EQ(data,
+              std::vector<uint8_t>(decoded.data, decoded.data + decoded.size));
+    free(expected.data);
+  }
+  RLE_context_free(&context);
+  ASSERT_EQ(nullptr, context.buffer);
+}
+
+TEST(rleContext, steadyStateReusesBuffer) {
+  std::vector<uint8_t> data = sampleData(20000, 3);
+  RLE_Data encoded = {NULL, 0};
+  RLE_Context context;
+  RLE_Span result;
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), (uint32_t)data.size(), &encoded));
+  RLE_context_init(&context, NULL);
+  ASSERT_EQ(RLE_OK, RLE_context_reserve(&context, 30000));
+  const uint8_t *buffer = context.buffer;
+  uint32_t capacity = context.capacity;
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(RLE_OK, RLE_context_encode(&context, data.data(),
+                                         (uint32_t)data.size(), &result));
+    ASSERT_EQ(RLE_OK, RLE_context_decode(&context, encoded.data, encoded.size,
+                                         &result));
+    ASSERT_EQ(buffer, result.data);
+    ASSERT_EQ(buffer, context.buffer);
+    ASSERT_EQ(capacity, context.capacity);
+  }
+  free(encoded.data);
+  RLE_context_free(&context);
+}
+
+TEST(rleContext, decodeLimits) {
+  uint8_t data[] = {127, 65, 127, 66};
+  uint8_t malformed[] = {5, 65, 0x83, 66};
+  RLE_DecodeOptions options = {200, 0};
+  RLE_Context context;
+  RLE_Span result;
+
+  RLE_context_init(&context, &options);
+  ASSERT_EQ(RLE_ERROR_LIMIT,
+            RLE_context_decode(&context, data, sizeof(data), &result));
+  ASSERT_EQ(RLE_OK, RLE_context_reserve(&context, 1000));
+  ASSERT_EQ(RLE_ERROR_LIMIT,
+            RLE_context_decode(&context, data, sizeof(data), &result));
+  ASSERT_EQ(RLE_ERROR, RLE_context_decode(&context, malformed,
+                                          sizeof(malformed), &result));
+
+  context.options.maxOutputSize = 254;
+  ASSERT_EQ(RLE_OK, RLE_context_decode(&context, data, sizeof(data), &result));
+  ASSERT_EQ(254u, result.size);
+  RLE_context_free(&context);
+}
+
+TEST(rleContext, decodeMalformedTail) {
+  uint8_t data[] = {127, 65, 127, 66, 0x83, 67};
+  RLE_Context context;
+  RLE_Span result;
+
+  // Detected by the one pass decoding to a large buffer.
+  RLE_context_init(&context, NULL);
+  ASSERT_EQ(RLE_OK, RLE_context_reserve(&context, 1000));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_context_decode(&context, data, sizeof(data), &result));
+
+  // Detected by the size scan after the small buffer overflows.
+  RLE_context_free(&context);
+  ASSERT_EQ(RLE_OK, RLE_context_reserve(&context, 100));
+  uint32_t capacity = context.capacity;
+  ASSERT_EQ(RLE_ERROR,
+            RLE_context_decode(&context, data, sizeof(data), &result));
+  ASSERT_EQ(capacity, context.capacity);
+
+  ASSERT_EQ(RLE_OK, RLE_context_decode(&context, data, 4, &result));
+  ASSERT_EQ(254u, result.size);
+  ASSERT_EQ('A', result.data[0]);
+  ASSERT_EQ('B', result.data[253]);
+  RLE_context_free(&context);
+}
@@ -0,0 +1,187 @@
+/*!
+ * \file    tests_corpus.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of the synthetic corpus generator and of RLE coding of
+ * the generated data.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "corpus.h"
+#include "rle.h"
+#include "rle_stream.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> generate(const CorpusOptions &options,
+                                     uint32_t size, uint32_t chunk);
+static std::vector<CorpusOptions> sampleOptions(uint64_t seed);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> generate(const CorpusOptions &options,
+                                     uint32_t size, uint32_t chunk) {
+  std::vector<uint8_t> data(size);
+  Corpus corpus;
+
+  bool ok = CORPUS_init(&corpus, &options);
+  EXPECT_TRUE(ok);
+  if (!ok) {
+    return data;
+  }
+  for (uint32_t pos = 0; pos < size; pos += chunk) {
+    CORPUS_fill(&corpus, &data[pos], size - pos < chunk ? size - pos : chunk);
+  }
+  CORPUS_free(&corpus);
+  return data;
+}
+
+static std::vector<CorpusOptions> sampleOptions(uint64_t seed) {
+  std::vector<CorpusOptions> samples;
+  CorpusOptions options = CORPUS_default_options(seed);
+
+  samples.push_back(options);
+  options.literals = 0.3;
+  options.alphabet = 3;
+  samples.push_back(options);
+  options.distribution = CORPUS_ZIPF;
+  options.exponent = 1.2;
+  options.maxLength = 1000;
+  samples.push_back(options);
+  options.distribution = CORPUS_FIXED;
+  options.maxLength = 0;
+  options.literals = 0.0;
+  options.alphabet = 256;
+  for (double length : {1.0, 2.0, 127.0, 128.0, 129.0, 256.0, 4096.0}) {
+    options.mean = length;
+    samples.push_back(options);
+  }
+  options.mean = 1.0;
+  options.alphabet = 2;
+  samples.push_back(options);
+  options.literals = 1.0;
+  options.alphabet = 256;
+  options.distribution = CORPUS_GEOMETRIC;
+  options.mean = 1000;
+  samples.push_back(options);
+  return samples;
+}
+
+TEST(rleCorpus, wrongOptions) {
+  Corpus corpus;
+  CorpusOptions options = CORPUS_default_options(1);
+
+  ASSERT_FALSE(CORPUS_init(NULL, &options));
+  ASSERT_FALSE(CORPUS_init(&corpus, NULL));
+  options.alphabet = 0;
+  ASSERT_FALSE(CORPUS_init(&corpus, &options));
+  options.alphabet = 257;
+  ASSERT_FALSE(CORPUS_init(&corpus, &options));
+  options = CORPUS_default_options(1);
+  options.mean = 0.5;
+  ASSERT_FALSE(CORPUS_init(&corpus, &options));
+  options = CORPUS_default_options(1);
+  options.literals = 1.5;
+  ASSERT_FALSE(CORPUS_init(&corpus, &options));
+  options = CORPUS_default_options(1);
+  options.distribution = CORPUS_ZIPF;
+  options.exponent = 0.0;
+  ASSERT_FALSE(CORPUS_init(&corpus, &options));
+}
+
+TEST(rleCorpus, reproducible) {
+  for (const CorpusOptions &options : sampleOptions(42)) {
+    std::vector<uint8_t> data = generate(options, 100000, 100000);
+    ASSERT_EQ(data, generate(options, 100000, 100000));
+    ASSERT_EQ(data, generate(options, 100000, 777));
+  }
+
+  CorpusOptions other = CORPUS_default_options(43);
+  ASSERT_NE(generate(CORPUS_default_options(42), 1000, 1000),
+            generate(other, 1000, 1000));
+}
+
+TEST(rleCorpus, fixedRuns) {
+  CorpusOptions options = CORPUS_default_options(7);
+  options.distribution = CORPUS_FIXED;
+  options.mean = 128;
+  options.alphabet = 4;
+  std::vector<uint8_t> data = generate(options, 128 * 50, 1000);
+
+  // every run has exactly 128 bytes, so it is encoded as two run tokens
+  for (size_t i = 1; i < data.size(); ++i) {
+    ASSERT_EQ(i % 128 == 0, data[i] != data[i - 1]) << i;
+    ASSERT_LT(data[i], 4);
+  }
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+  ASSERT_EQ(50u * 4, encoded.size);
+  free(encoded.data);
+}
+
+TEST(rleCorpus, alternating) {
+  CorpusOptions options = CORPUS_default_options(9);
+  options.distribution = CORPUS_FIXED;
+  options.mean = 1;
+  options.alphabet = 2;
+  std::vector<uint8_t> data = generate(options, 1000, 33);
+
+  for (size_t i = 1; i < data.size(); ++i) {
+    ASSERT_EQ(data[i - 1] ^ 1, data[i]);
+  }
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+  ASSERT_LE(encoded.size, RLE_encode_bound(data.size()));
+  free(encoded.data);
+}
+
+TEST(rleCorpus, roundTrip) {
+  for (uint64_t seed = 1; seed <= 3; ++seed) {
+    for (const CorpusOptions &options : sampleOptions(seed)) {
+      std::vector<uint8_t> data = generate(options, 200000, 4096);
+      RLE_Data encoded = {NULL, 0};
+      RLE_Data decoded = {NULL, 0};
+
+      ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+      ASSERT_LE(encoded.size, RLE_encode_bound(data.size()));
+      ASSERT_EQ(RLE_OK, RLE_decode(encoded.data, encoded.size, &decoded));
+      ASSERT_EQ(data, std::vector<uint8_t>(decoded.data,
+                                           decoded.data + decoded.size));
+
+      // the stream encoder fed by small chunks matches the block encoder
+      std::vector<uint8_t> streamed(RLE_encoder_bound(999));
+      std::vector<uint8_t> result;
+      RLE_Encoder encoder;
+      uint32_t outLen;
+      RLE_encoder_init(&encoder);
+      for (size_t pos = 0; pos < data.size(); pos += 999) {
+        uint32_t n = (uint32_t)std::min<size_t>(999, data.size() - pos);
+        ASSERT_EQ(RLE_OK, RLE_encoder_feed(&encoder, &data[pos], n,
+                                           streamed.data(), &outLen));
+        result.insert(result.end(), streamed.begin(),
+                      streamed.begin() + outLen);
+      }
+      streamed.resize(RLE_encoder_bound(0));
+      ASSERT_EQ(RLE_OK, RLE_encoder_finish(&encoder, streamed.data(), &outLen));
+      result.insert(result.end(), streamed.begin(), streamed.begin() + outLen);
+      ASSERT_EQ(std::vector<uint8_t>(encoded.data, encoded.data + encoded.size),
+                result);
+
+      free(encoded.data);
+      free(decoded.data);
+    }
+  }
+}
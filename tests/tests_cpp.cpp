@@ -0,0 +1,230 @@
+/*!
+ * \file    tests_cpp.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of the C++ encoding and decoding functions.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#if __cplusplus >= 201703L
+#include <array>
+#endif
+
+#include "gtest/gtest.h"
+#include "rle.hpp"
+#include "tests_data.hpp"
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+TEST(rleCpp, bufferIsMoveOnly) {
+  ASSERT_FALSE(std::is_copy_constructible<rle::buffer>::value);
+  ASSERT_FALSE(std::is_copy_assignable<rle::buffer>::value);
+  ASSERT_TRUE(std::is_nothrow_move_constructible<rle::buffer>::value);
+
+  rle::buffer a = rle::encode(std::string("aaaab"));
+  const uint8_t *data = a.data();
+  rle::buffer b = std::move(a);
+
+  ASSERT_EQ(data, b.data());
+  ASSERT_TRUE(a.empty());
+  ASSERT_EQ(nullptr, a.data());
+
+  RLE_Data released = b.release();
+  ASSERT_EQ(data, released.data);
+  ASSERT_EQ(4u, released.size);
+  ASSERT_TRUE(b.empty());
+  free(released.data);
+}
+
+TEST(rleCpp, encodeDecodeBuffer) {
+  std::vector<uint8_t> data = sampleData(100000, 13);
+  RLE_Data expected = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), (uint32_t)data.size(), &expected));
+
+  rle::buffer encoded = rle::encode(data);
+  ASSERT_EQ(std::vector<uint8_t>(expected.data, expected.data + expected.size),
+            std::vector<uint8_t>(encoded.begin(), encoded.end()));
+  free(expected.data);
+
+  rle::buffer decoded = rle::decode(encoded);
+  ASSERT_EQ(data, std::vector<uint8_t>(decoded.begin(), decoded.end()));
+
+  std::vector<uint8_t> viewed(rle::view(encoded).begin(),
+                              rle::view(encoded).end());
+  ASSERT_EQ(data, viewed);
+}
+
+TEST(rleCpp, appendReusesCapacity) {
+  std::vector<uint8_t> data = sampleData(50000, 13);
+  std::vector<uint8_t> encoded = {1, 2, 3};
+
+  rle::encode(data, encoded);
+  rle::buffer expected = rle::encode(data);
+  ASSERT_EQ(3 + expected.size(), encoded.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), &encoded[3]));
+
+  encoded.erase(encoded.begin(), encoded.begin() + 3);
+  std::vector<uint8_t> decoded;
+  decoded.reserve(data.size());
+  const uint8_t *storage = decoded.data();
+  rle::decode(encoded, decoded);
+  ASSERT_EQ(data, decoded);
+  ASSERT_EQ(storage, decoded.data());
+
+  decoded.clear();
+  rle::decode(encoded, decoded);
+  ASSERT_EQ(data, decoded);
+  ASSERT_EQ(storage, decoded.data());
+}
+
+TEST(rleCpp, appendToString) {
+  std::string text = "xxxxxxxxyz";
+  std::string encoded = "head";
+  std::string decoded = "head";
+
+  rle::encode(text, encoded);
+  ASSERT_EQ("head\x08x\x82yz", encoded);
+  rle::decode(rle::bytes(encoded.data() + 4, encoded.size() - 4), decoded);
+  ASSERT_EQ("head" + text, decoded);
+}
+
+TEST(rleCpp, errors) {
+  std::vector<uint8_t> empty;
+  std::vector<uint8_t> malformed = {5, 65, 0x83, 66};
+  std::vector<uint8_t> out = {1, 2};
+  uint8_t bomb[] = {127, 65, 127, 66};
+  RLE_DecodeOptions options = {200, 0};
+
+  ASSERT_THROW(rle::encode(empty), rle::error);
+  ASSERT_THROW(rle::encode(empty, out), rle::error);
+  ASSERT_THROW(rle::decode(malformed), rle::error);
+  ASSERT_THROW(rle::decode(malformed, out), rle::error);
+  ASSERT_EQ(std::vector<uint8_t>({1, 2}), out);
+
+  try {
+    rle::decode(rle::bytes(bomb, sizeof(bomb)), options);
+    FAIL();
+  } catch (const rle::error &e) {
+    ASSERT_EQ(RLE_ERROR_LIMIT, e.state());
+  }
+}
+
+#if __cplusplus >= 202002L
+TEST(rleCpp, spanOfBytes) {
+  std::vector<uint8_t> data = sampleData(1000, 13);
+  std::span<const std::byte> in = std::as_bytes(std::span(data));
+
+  rle::buffer encoded = rle::encode(in);
+  std::vector<std::byte> decoded;
+  rle::decode(encoded, decoded);
+  ASSERT_EQ(data.size(), decoded.size());
+  ASSERT_TRUE(std::equal(in.begin(), in.end(), decoded.begin()));
+}
+#endif
+
+#ifdef RLE_HAS_PMR
+TEST(rleCpp, memoryResource) {
+  std::vector<uint8_t> data = sampleData(20000, 13);
+  std::array<std::byte, 48 * 1024> arena;
+  std::pmr::monotonic_buffer_resource resource(
+      arena.data(), arena.size(), std::pmr::null_memory_resource());
+
+  std::pmr::vector<uint8_t> encoded = rle::encode(data, &resource);
+  std::pmr::vector<uint8_t> decoded = rle::decode(encoded, &resource);
+
+  ASSERT_EQ(&resource, encoded.get_allocator().resource());
+  ASSERT_EQ(&resource, decoded.get_allocator().resource());
+  ASSERT_TRUE(std::equal(data.begin(), data.end(), decoded.begin(),
+                         decoded.end()));
+  ASSERT_GE((const void *)decoded.data(), (const void *)arena.data());
+  ASSERT_LT((const void *)decoded.data(),
+            (const void *)(arena.data() + arena.size()));
+
+  // the resource refuses to grow, the error leaves it usable
+  ASSERT_THROW(rle::decode(encoded, &resource), std::bad_alloc);
+  ASSERT_THROW(rle::decode(data, &resource), rle::error);
+}
+#endif
+
+#ifdef RLE_HAS_COROUTINES
+TEST(rleCpp, encodeStream) {
+  std::vector<uint8_t> data = sampleData(300000, 13);
+  rle::buffer expected = rle::encode(data);
+
+  for (uint32_t chunk : {1u, 1000u, 4096u, RLE_IO_CHUNK_SIZE}) {
+    std::vector<rle::bytes> pieces;
+    for (size_t pos = 0; pos < data.size(); pos += 7777) {
+      pieces.emplace_back(&data[pos],
+                          std::min<size_t>(7777, data.size() - pos));
+    }
+
+    std::vector<uint8_t> encoded;
+    size_t partial = 0;
+    for (rle::bytes out : rle::encode_stream(std::views::all(pieces), chunk)) {
+      ASSERT_EQ(0u, partial);
+      ASSERT_LE(out.size(), chunk);
+      partial += out.size() < chunk;
+      encoded.insert(encoded.end(), out.data(), out.data() + out.size());
+    }
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), encoded.begin(),
+                           encoded.end()));
+  }
+}
+
+TEST(rleCpp, decodeStreamPipeline) {
+  std::vector<uint8_t> data = sampleData(300000, 13);
+  std::vector<rle::bytes> pieces = {rle::bytes(data)};
+  std::vector<uint8_t> decoded;
+
+  // the encoded chunks feed the decoder as they are produced
+  for (rle::bytes out :
+       rle::decode_stream(rle::encode_stream(std::views::all(pieces), 333),
+                          4096)) {
+    decoded.insert(decoded.end(), out.data(), out.data() + out.size());
+  }
+  ASSERT_EQ(data, decoded);
+}
+
+TEST(rleCpp, streamErrors) {
+  std::vector<uint8_t> malformed = {5, 65, 0x83, 66};
+  std::vector<uint8_t> truncated = {5, 65, 0x83, 66, 67};
+  std::vector<rle::bytes> empty;
+  std::vector<rle::bytes> pieces;
+
+  ASSERT_TRUE(rle::encode_stream(empty).begin() == std::default_sentinel);
+
+  pieces = {rle::bytes(malformed)};
+  rle::chunk_stream stream = rle::decode_stream(pieces, 1);
+  rle::chunk_stream::iterator it = stream.begin();
+  ASSERT_EQ(65, *(*it).data());
+  ASSERT_THROW(
+      {
+        while (it != stream.end()) {
+          ++it;
+        }
+      },
+      rle::error);
+
+  pieces = {rle::bytes(truncated)};
+  rle::chunk_stream rest = rle::decode_stream(pieces);
+  ASSERT_THROW(rest.begin(), rle::error);
+}
+#endif
@@ -0,0 +1,47 @@
+/*!
+ * \file    tests_data.hpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Sample data shared by the unit tests.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+#ifndef TESTS_DATA_HPP
+#define TESTS_DATA_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vector>
+
+/* Exported functions declarations -------------------------------------------*/
+/*! Generates data of runs mixed with random literal blocks. The same seed
+ * gives the same data.
+ *
+ * \param[in]   size    Size of the data.
+ * \param[in]   seed    Seed of the generator.
+ *
+ * \return Generated data.
+ */
+inline std::vector<uint8_t> sampleData(size_t size, unsigned seed) {
+  std::vector<uint8_t> data;
+  srand(seed);
+  while (data.size() < size) {
+    if (rand() % 4 == 0) {
+      for (int i = rand() % 600; i >= 0; --i) {
+        data.push_back((uint8_t)rand());
+      }
+    } else {
+      data.insert(data.end(), rand() % 300 + 1, (uint8_t)rand());
+    }
+  }
+  data.resize(size);
+  return data;
+}
+
+#endif  // TESTS_DATA_HPP
@@ -0,0 +1,89 @@
+/*!
+ * \file    tests_direct.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of RLE decoding to files bypassing the page cache.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_direct.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/*! Output file created in the working directory of the tests. */
+#define OUTPUT_PATH "rle_direct_output.bin"
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> readFile(const char *path);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> readFile(const char *path) {
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t n;
+  FILE *file = fopen(path, "rb");
+
+  EXPECT_NE(nullptr, file);
+  if (file == NULL) {
+    return data;
+  }
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + n);
+  }
+  fclose(file);
+  return data;
+}
+
+TEST(rleDirect, decodeWrongInputs) {
+  uint8_t in[] = {0x81, 65};
+  ASSERT_EQ(RLE_ERROR, RLE_decode_direct(NULL, 0, OUTPUT_PATH, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_direct(in, sizeof(in), NULL, NULL, NULL));
+}
+
+TEST(rleDirect, decodeMalformedCreatesNothing) {
+  uint8_t in[] = {5, 65, 0x83, 66};
+  remove(OUTPUT_PATH);
+
+  ASSERT_EQ(RLE_ERROR,
+            RLE_decode_direct(in, sizeof(in), OUTPUT_PATH, NULL, NULL));
+  ASSERT_EQ(nullptr, fopen(OUTPUT_PATH, "rb"));
+}
+
+TEST(rleDirect, decodeSizes) {
+  // unaligned sizes, exactly one buffer and more buffers than two
+  for (uint32_t size : {1u, 4095u, 4096u, 70000u, RLE_DIRECT_BUFFER_SIZE,
+                        3 * RLE_DIRECT_BUFFER_SIZE + 12345u}) {
+    std::vector<uint8_t> data(size);
+    for (uint32_t i = 0; i < size; ++i) {
+      data[i] = (uint8_t)(i / 100 % 7 == 0 ? i * 31 : i / 100);
+    }
+    RLE_Data encoded = {NULL, 0};
+    ASSERT_EQ(RLE_OK, RLE_encode(data.data(), size, &encoded));
+
+    uint64_t written = 0;
+    bool direct;
+    ASSERT_EQ(RLE_OK, RLE_decode_direct(encoded.data, encoded.size,
+                                        OUTPUT_PATH, &written, &direct));
+    ASSERT_EQ(size, written);
+    ASSERT_EQ(data, readFile(OUTPUT_PATH)) << "size " << size;
+    free(encoded.data);
+  }
+  remove(OUTPUT_PATH);
+}
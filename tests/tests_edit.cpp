@@ -0,0 +1,293 @@
+/*!
+ * \file    tests_edit.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of editing operations on RLE encoded data.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_edit.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> encode(const std::vector<uint8_t> &data);
+static std::vector<uint8_t> decode(const RLE_Data &data);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> encode(const std::vector<uint8_t> &data) {
+  RLE_Data encoded = {NULL, 0};
+  EXPECT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+  std::vector<uint8_t> result(encoded.data, encoded.data + encoded.size);
+  free(encoded.data);
+  return result;
+}
+
+static std::vector<uint8_t> decode(const RLE_Data &data) {
+  RLE_Data decoded = {NULL, 0};
+  EXPECT_EQ(RLE_OK, RLE_decode(data.data, data.size, &decoded));
+  std::vector<uint8_t> result(decoded.data, decoded.data + decoded.size);
+  free(decoded.data);
+  return result;
+}
+
+TEST(rleEdit, concatWrongInputs) {
+  RLE_Data result = {NULL, 0};
+  uint8_t in[] = {3, 65};
+  uint8_t malformed[] = {3, 65, 0x82, 66};
+
+  ASSERT_EQ(RLE_ERROR, RLE_concat(in, sizeof(in), NULL, 0, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_concat(in, sizeof(in), in, sizeof(in), NULL));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_concat(malformed, sizeof(malformed), in, sizeof(in), &result));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_concat(in, sizeof(in), malformed, sizeof(malformed), &result));
+}
+
+TEST(rleEdit, concatMergesRuns) {
+  RLE_Data result = {NULL, 0};
+  uint8_t first[] = {0x82, 66, 67, 100, 65};
+  uint8_t second[] = {50, 65, 0x81, 66};
+  uint8_t expected[] = {0x82, 66, 67, 127, 65, 23, 65, 0x81, 66};
+
+  ASSERT_EQ(RLE_OK, RLE_concat(first, sizeof(first), second, sizeof(second),
+                               &result));
+
+  ASSERT_EQ(std::vector<uint8_t>(expected, expected + sizeof(expected)),
+            std::vector<uint8_t>(result.data, result.data + result.size));
+  free(result.data);
+}
+
+TEST(rleEdit, concatCoalescesLiterals) {
+  std::vector<uint8_t> a;
+  std::vector<uint8_t> b;
+  for (int i = 0; i < 100; ++i) {
+    a.push_back((uint8_t)i);
+    b.push_back((uint8_t)(100 + i));
+  }
+  std::vector<uint8_t> joined = a;
+  joined.insert(joined.end(), b.begin(), b.end());
+  std::vector<uint8_t> encodedA = encode(a);
+  std::vector<uint8_t> encodedB = encode(b);
+  RLE_Data result = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_concat(encodedA.data(), encodedA.size(),
+                               encodedB.data(), encodedB.size(), &result));
+
+  ASSERT_EQ(encode(joined),
+            std::vector<uint8_t>(result.data, result.data + result.size));
+  free(result.data);
+}
+
+TEST(rleEdit, appendToEmpty) {
+  RLE_Data data = {NULL, 0};
+  uint8_t in[] = {3, 65};
+
+  ASSERT_EQ(RLE_OK, RLE_append(&data, in, sizeof(in)));
+  ASSERT_EQ(RLE_OK, RLE_append(&data, in, sizeof(in)));
+
+  ASSERT_EQ(std::vector<uint8_t>({6, 65}),
+            std::vector<uint8_t>(data.data, data.data + data.size));
+  free(data.data);
+}
+
+TEST(rleEdit, appendSegmentsMatchesDecode) {
+  std::vector<uint8_t> input;
+  RLE_Data data = {NULL, 0};
+
+  for (int segment = 0; segment < 50; ++segment) {
+    std::vector<uint8_t> chunk;
+    for (int i = 0; i < 40; ++i) {
+      chunk.insert(chunk.end(), 1 + (segment + i) % 4,
+                   (uint8_t)((segment * i) % 3));
+    }
+    std::vector<uint8_t> encoded = encode(chunk);
+    input.insert(input.end(), chunk.begin(), chunk.end());
+    ASSERT_EQ(RLE_OK, RLE_append(&data, encoded.data(), encoded.size()));
+  }
+
+  ASSERT_EQ(input, decode(data));
+  free(data.data);
+}
+
+TEST(rleEdit, appendWithLastToken) {
+  std::vector<uint8_t> input;
+  RLE_Data data = {NULL, 0};
+  uint32_t last = 0;
+
+  for (int segment = 0; segment < 200; ++segment) {
+    std::vector<uint8_t> chunk;
+    for (int i = 0; i < 10 + segment % 7; ++i) {
+      chunk.insert(chunk.end(), 1 + (segment + i) % 5,
+                   (uint8_t)((segment * i) % 3));
+    }
+    std::vector<uint8_t> encoded = encode(chunk);
+    input.insert(input.end(), chunk.begin(), chunk.end());
+    ASSERT_EQ(RLE_OK,
+              RLE_append_ex(&data, encoded.data(), encoded.size(), &last));
+
+    uint32_t found = RLE_EDIT_LAST_UNKNOWN;
+    RLE_Data joined = {NULL, 0};
+    ASSERT_EQ(RLE_OK, RLE_concat_ex(NULL, 0, data.data, data.size, &joined,
+                                    &found));
+    ASSERT_EQ(found, last);
+    free(joined.data);
+  }
+
+  ASSERT_EQ(input, decode(data));
+  free(data.data);
+}
+
+TEST(rleEdit, appendWrongLastToken) {
+  uint8_t first[] = {3, 65, 0x82, 1, 2};
+  uint8_t in[] = {3, 66};
+  RLE_Data data = {(uint8_t *)malloc(sizeof(first)), sizeof(first)};
+  memcpy(data.data, first, sizeof(first));
+
+  uint32_t last = 0;
+  ASSERT_EQ(RLE_ERROR, RLE_append_ex(&data, in, sizeof(in), &last));
+  last = sizeof(first);
+  ASSERT_EQ(RLE_ERROR, RLE_append_ex(&data, in, sizeof(in), &last));
+  last = 2;
+  ASSERT_EQ(RLE_OK, RLE_append_ex(&data, in, sizeof(in), &last));
+  ASSERT_EQ(5u, last);
+  ASSERT_EQ(std::vector<uint8_t>({3, 65, 0x82, 1, 2, 3, 66}),
+            std::vector<uint8_t>(data.data, data.data + data.size));
+  free(data.data);
+}
+
+TEST(rleEdit, patchWrongInputs) {
+  uint8_t in[] = {3, 65};
+  RLE_Data data = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_append(&data, in, sizeof(in)));
+
+  ASSERT_EQ(RLE_ERROR, RLE_patch(NULL, 0, 0, in, 1));
+  ASSERT_EQ(RLE_ERROR, RLE_patch(&data, 2, 2, in, 1));
+  ASSERT_EQ(RLE_ERROR, RLE_patch(&data, 0, 1, NULL, 1));
+  ASSERT_EQ(std::vector<uint8_t>({3, 65}),
+            std::vector<uint8_t>(data.data, data.data + data.size));
+  free(data.data);
+}
+
+TEST(rleEdit, patchSplitsRun) {
+  uint8_t in[] = {100, 65};
+  uint8_t replacement[] = {66};
+  RLE_Data data = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_append(&data, in, sizeof(in)));
+
+  ASSERT_EQ(RLE_OK, RLE_patch(&data, 50, 1, replacement, 1));
+
+  ASSERT_EQ(std::vector<uint8_t>({50, 65, 0x81, 66, 49, 65}),
+            std::vector<uint8_t>(data.data, data.data + data.size));
+  free(data.data);
+}
+
+TEST(rleEdit, patchStopsAtRange) {
+  // The tail is neither walked nor validated, so it is moved as is.
+  uint8_t in[] = {10, 65, 10, 66, 0x85, 1};
+  uint8_t replacement[] = {67};
+  RLE_Data data = {(uint8_t *)malloc(sizeof(in)), sizeof(in)};
+  memcpy(data.data, in, sizeof(in));
+
+  ASSERT_EQ(RLE_OK, RLE_patch(&data, 0, 1, replacement, 1));
+
+  ASSERT_EQ(std::vector<uint8_t>({0x81, 67, 9, 65, 10, 66, 0x85, 1}),
+            std::vector<uint8_t>(data.data, data.data + data.size));
+  free(data.data);
+}
+
+TEST(rleEdit, patchMergesRuns) {
+  uint8_t in[] = {10, 65, 0x81, 66, 10, 65};
+  uint8_t replacement[] = {65};
+  RLE_Data data = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_append(&data, in, sizeof(in)));
+
+  ASSERT_EQ(RLE_OK, RLE_patch(&data, 10, 1, replacement, 1));
+
+  ASSERT_EQ(std::vector<uint8_t>({21, 65}),
+            std::vector<uint8_t>(data.data, data.data + data.size));
+  free(data.data);
+}
+
+TEST(rleEdit, patchInsertAndRemove) {
+  std::vector<uint8_t> input;
+  for (int i = 0; i < 3000; ++i) {
+    input.insert(input.end(), 1 + i % 5, (uint8_t)(i % 7));
+  }
+  std::vector<uint8_t> encoded = encode(input);
+  RLE_Data data = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_append(&data, encoded.data(), encoded.size()));
+
+  struct {
+    uint32_t offset;
+    uint32_t length;
+    std::vector<uint8_t> replacement;
+  } edits[] = {{0, 0, {9, 9, 9}},
+               {17, 3, {}},
+               {500, 1, {1, 2, 3, 4, 5, 5, 5}},
+               {1000, 300, std::vector<uint8_t>(200, 4)},
+               {8000, 0, {8, 8}}};
+
+  for (const auto &edit : edits) {
+    input.erase(input.begin() + edit.offset,
+                input.begin() + edit.offset + edit.length);
+    input.insert(input.begin() + edit.offset, edit.replacement.begin(),
+                 edit.replacement.end());
+    ASSERT_EQ(RLE_OK,
+              RLE_patch(&data, edit.offset, edit.length,
+                        edit.replacement.data(), edit.replacement.size()));
+    ASSERT_EQ(input, decode(data));
+  }
+  free(data.data);
+}
+
+TEST(rleEdit, patchInsideStoredBlocks) {
+  std::vector<uint8_t> input;
+  for (int i = 0; i < 5000; ++i) {
+    input.push_back((uint8_t)(i * 13));
+  }
+  std::vector<uint8_t> original = input;
+  std::vector<uint8_t> encoded = encode(input);
+  ASSERT_EQ(0x80, encoded[0]);
+  RLE_Data data = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_append(&data, encoded.data(), encoded.size()));
+
+  std::vector<uint8_t> replacement(300, 7);
+  input.erase(input.begin() + 1000, input.begin() + 1010);
+  input.insert(input.begin() + 1000, replacement.begin(), replacement.end());
+  ASSERT_EQ(RLE_OK, RLE_patch(&data, 1000, 10, replacement.data(),
+                              replacement.size()));
+  ASSERT_EQ(input, decode(data));
+
+  input.insert(input.end(), original.begin(), original.end());
+  ASSERT_EQ(RLE_OK, RLE_append(&data, encoded.data(), encoded.size()));
+  ASSERT_EQ(input, decode(data));
+  free(data.data);
+}
+
+TEST(rleEdit, patchRemoveAll) {
+  uint8_t in[] = {10, 65, 0x81, 66};
+  RLE_Data data = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_append(&data, in, sizeof(in)));
+
+  ASSERT_EQ(RLE_OK, RLE_patch(&data, 0, 11, NULL, 0));
+
+  ASSERT_EQ(NULL, data.data);
+  ASSERT_EQ(0u, data.size);
+}
@@ -0,0 +1,148 @@
+/*!
+ * \file    tests_entropy.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of entropy coded RLE.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_entropy.h"
+#include "rle_private.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> skewedData(size_t size, unsigned seed);
+static void expectRoundTrip(const std::vector<uint8_t> &data);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> skewedData(size_t size, unsigned seed) {
+  // Mostly short runs of a few values, as in log data.
+  std::vector<uint8_t> data;
+  srand(seed);
+  while (data.size() < size) {
+    uint8_t value = rand() % 8 == 0 ? (uint8_t)rand() : (uint8_t)(rand() % 4);
+    size_t length = rand() % 4 == 0 ? rand() % 6 + 2 : 1;
+    data.insert(data.end(), length, value);
+  }
+  data.resize(size);
+  return data;
+}
+
+static void expectRoundTrip(const std::vector<uint8_t> &data) {
+  RLE_Data encoded = {NULL, 0};
+  RLE_Data decoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_encode_entropy(data.data(), data.size(), &encoded));
+  ASSERT_EQ(RLE_OK, RLE_decode_entropy(encoded.data, encoded.size, &decoded));
+  ASSERT_EQ(data, std::vector<uint8_t>(decoded.data,
+                                       decoded.data + decoded.size));
+  free(encoded.data);
+  free(decoded.data);
+}
+
+TEST(rleEntropy, wrongInputs) {
+  RLE_Data result = {NULL, 0};
+  uint8_t in[] = {1, 2, 3};
+
+  ASSERT_EQ(RLE_ERROR, RLE_encode_entropy(NULL, 3, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_entropy(in, 0, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_entropy(in, 3, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_entropy(in, sizeof(in), &result));
+}
+
+TEST(rleEntropy, roundTrip) {
+  expectRoundTrip({42});
+  expectRoundTrip(std::vector<uint8_t>(1000, 7));
+  expectRoundTrip(skewedData(100000, 3));
+
+  // Uniform bytes need the full alphabet.
+  std::vector<uint8_t> uniform(50000);
+  for (size_t i = 0; i < uniform.size(); i++) {
+    uniform[i] = (uint8_t)(i * 7919 % 251 + i / 251);
+  }
+  expectRoundTrip(uniform);
+
+  // Fibonacci frequencies exceed the code length limit without flattening.
+  std::vector<uint8_t> fibonacci;
+  size_t a = 1, b = 1;
+  for (uint8_t s = 0; s < 20; s++) {
+    for (size_t k = 0; k < a; k++) {
+      fibonacci.push_back(s);
+      fibonacci.push_back(s + 100);
+    }
+    size_t c = a + b;
+    a = b;
+    b = c;
+  }
+  expectRoundTrip(fibonacci);
+}
+
+TEST(rleEntropy, smallerThanRle) {
+  std::vector<uint8_t> data = skewedData(100000, 5);
+  RLE_Data plain = {NULL, 0};
+  RLE_Data entropy = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &plain));
+  ASSERT_EQ(RLE_OK, RLE_encode_entropy(data.data(), data.size(), &entropy));
+  ASSERT_LT(entropy.size * 2, plain.size);
+  free(plain.data);
+  free(entropy.data);
+}
+
+TEST(rleEntropy, corruptedData) {
+  std::vector<uint8_t> data = skewedData(5000, 9);
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode_entropy(data.data(), data.size(), &encoded));
+
+  RLE_Data decoded = {NULL, 0};
+  ASSERT_EQ(RLE_ERROR, RLE_decode_entropy(encoded.data, encoded.size - 1,
+                                          &decoded));
+
+  srand(1);
+  for (int k = 0; k < 200; k++) {
+    std::vector<uint8_t> corrupted(encoded.data, encoded.data + encoded.size);
+    corrupted[rand() % corrupted.size()] ^= (uint8_t)(1 << (rand() % 8));
+    if (RLE_decode_entropy(corrupted.data(), corrupted.size(), &decoded) ==
+        RLE_OK) {
+      free(decoded.data);
+    }
+  }
+  free(encoded.data);
+}
+
+TEST(rleEntropy, runsUseTwoSymbolEntries) {
+  // Runs only, so every token is a header and a run value.
+  std::vector<uint8_t> data;
+  srand(5);
+  while (data.size() < 100000) {
+    data.insert(data.end(), rand() % 6 + 3, (uint8_t)(rand() % 3));
+  }
+  RLE_Data encoded = {NULL, 0};
+  RLE_Data decoded = {NULL, 0};
+  RleLookupStats stats = {0, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_encode_entropy(data.data(), data.size(), &encoded));
+  ASSERT_EQ(RLE_OK, rleDecodeEntropy(encoded.data, encoded.size, &decoded,
+                                     &stats));
+  ASSERT_EQ(data, std::vector<uint8_t>(decoded.data,
+                                       decoded.data + decoded.size));
+  ASSERT_GT(stats.pairs * 10, stats.lookups * 9);
+  free(encoded.data);
+  free(decoded.data);
+}
@@ -0,0 +1,149 @@
+/*!
+ * \file    tests_estimate.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of RLE compressibility estimation.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_entropy.h"
+#include "rle_estimate.h"
+#include "rle_hybrid.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> runData(size_t size, unsigned seed);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> runData(size_t size, unsigned seed) {
+  std::vector<uint8_t> data;
+  srand(seed);
+  while (data.size() < size) {
+    size_t length = rand() % 3 == 0 ? rand() % 40 + 2 : 1;
+    data.insert(data.end(), length, (uint8_t)(rand() % 16));
+  }
+  data.resize(size);
+  return data;
+}
+
+TEST(rleEstimate, wrongInputs) {
+  RLE_Estimate estimate;
+  uint8_t in[] = {1, 2, 3};
+
+  ASSERT_EQ(RLE_ERROR, RLE_estimate(NULL, 3, NULL, &estimate));
+  ASSERT_EQ(RLE_ERROR, RLE_estimate(in, 0, NULL, &estimate));
+  ASSERT_EQ(RLE_ERROR, RLE_estimate(in, 3, NULL, NULL));
+}
+
+TEST(rleEstimate, smallDataExact) {
+  std::vector<uint8_t> data = runData(4096, 1);
+  RLE_Estimate estimate;
+  RLE_Data encoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_estimate(data.data(), data.size(), NULL, &estimate));
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+  ASSERT_EQ(data.size(), estimate.sampled);
+  ASSERT_EQ(encoded.size, estimate.size[RLE_MODE_BASIC]);
+  ASSERT_EQ(0u, estimate.error[RLE_MODE_BASIC]);
+  free(encoded.data);
+
+  ASSERT_EQ(RLE_OK, RLE_hybrid_encode(data.data(), data.size(), 0, &encoded));
+  ASSERT_EQ(encoded.size, estimate.size[RLE_MODE_HYBRID]);
+  free(encoded.data);
+
+  ASSERT_EQ(RLE_OK, RLE_encode_entropy(data.data(), data.size(), &encoded));
+  ASSERT_EQ(encoded.size, estimate.size[RLE_MODE_ENTROPY]);
+  free(encoded.data);
+}
+
+TEST(rleEstimate, exactWithinBound) {
+  for (unsigned seed = 0; seed < 50; seed++) {
+    std::vector<uint8_t> data = runData(64 + seed * 397 + seed % 7, seed);
+    RLE_EstimateOptions options = {20000, 0};
+    RLE_Estimate estimate;
+    RLE_Data encoded[RLE_MODE_COUNT];
+
+    ASSERT_EQ(RLE_OK,
+              RLE_estimate(data.data(), data.size(), &options, &estimate));
+    ASSERT_EQ(RLE_OK,
+              RLE_encode(data.data(), data.size(), &encoded[RLE_MODE_BASIC]));
+    ASSERT_EQ(RLE_OK, RLE_hybrid_encode(data.data(), data.size(), 0,
+                                        &encoded[RLE_MODE_HYBRID]));
+    ASSERT_EQ(RLE_OK, RLE_encode_entropy(data.data(), data.size(),
+                                         &encoded[RLE_MODE_ENTROPY]));
+
+    for (int mode = 0; mode < RLE_MODE_COUNT; mode++) {
+      ASSERT_NEAR(encoded[mode].size, estimate.size[mode],
+                  estimate.error[mode])
+          << "seed " << seed << ", mode " << mode;
+      free(encoded[mode].data);
+    }
+  }
+}
+
+TEST(rleEstimate, smallDataSampled) {
+  std::vector<uint8_t> data = runData(20000, 4);
+  RLE_Estimate estimate;
+  RLE_Data encoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_estimate(data.data(), data.size(), NULL, &estimate));
+  ASSERT_LE(estimate.sampled * 8, data.size());
+  ASSERT_GT(estimate.error[RLE_MODE_BASIC], 0u);
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+  ASSERT_NEAR(encoded.size, estimate.size[RLE_MODE_BASIC],
+              estimate.error[RLE_MODE_BASIC]);
+  free(encoded.data);
+}
+
+TEST(rleEstimate, sampledWithinBound) {
+  std::vector<uint8_t> data = runData(4000000, 2);
+  RLE_Estimate estimate;
+  RLE_Data encoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_estimate(data.data(), data.size(), NULL, &estimate));
+  ASSERT_LT(estimate.sampled * 50, data.size());
+  ASSERT_GT(estimate.error[RLE_MODE_BASIC], 0u);
+
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+  ASSERT_NEAR(encoded.size, estimate.size[RLE_MODE_BASIC],
+              estimate.error[RLE_MODE_BASIC]);
+  free(encoded.data);
+
+  ASSERT_EQ(RLE_OK, RLE_hybrid_encode(data.data(), data.size(), 0, &encoded));
+  ASSERT_NEAR(encoded.size, estimate.size[RLE_MODE_HYBRID],
+              estimate.error[RLE_MODE_HYBRID]);
+  free(encoded.data);
+}
+
+TEST(rleEstimate, options) {
+  std::vector<uint8_t> data = runData(1000000, 3);
+  RLE_EstimateOptions options = {1024, 8};
+  RLE_Estimate estimate;
+
+  ASSERT_EQ(RLE_OK,
+            RLE_estimate(data.data(), data.size(), &options, &estimate));
+  ASSERT_EQ(8u * 1024, estimate.sampled);
+
+  uint64_t runs = 1;
+  for (size_t i = 1; i < data.size(); i++) {
+    runs += data[i] != data[i - 1];
+  }
+  ASSERT_NEAR(runs, estimate.runs, runs / 10);
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file    tests_fd.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of RLE decoding to file descriptors.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_fd.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> readAll(FILE *file);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> readAll(FILE *file) {
+  std::vector<uint8_t> data;
+  uint8_t buffer[1024];
+  size_t n;
+
+  rewind(file);
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + n);
+  }
+  return data;
+}
+
+TEST(rleFd, decodeWrongInputs) {
+  uint8_t in[] = {0x81, 65};
+  ASSERT_EQ(RLE_ERROR, RLE_decode_fd(NULL, 0, 1, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_fd(in, sizeof(in), -1, NULL));
+}
+
+TEST(rleFd, decodeMalformedWritesNothing) {
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  uint8_t in[] = {5, 65, 0x83, 66};
+
+  ASSERT_EQ(RLE_ERROR, RLE_decode_fd(in, sizeof(in), fileno(file), NULL));
+  ASSERT_TRUE(readAll(file).empty());
+  fclose(file);
+}
+
+TEST(rleFd, decodeCombined) {
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  uint8_t data[] = {5, 65, 0x83, 66, 67, 68, 2, 65, 127, 69};
+  std::vector<uint8_t> expected(5, 65);
+  expected.insert(expected.end(), {66, 67, 68, 65, 65});
+  expected.insert(expected.end(), 127, 69);
+  uint64_t written = 0;
+
+  ASSERT_EQ(RLE_OK,
+            RLE_decode_fd(data, sizeof(data), fileno(file), &written));
+
+  ASSERT_EQ(expected.size(), written);
+  ASSERT_EQ(expected, readAll(file));
+  fclose(file);
+}
+
+TEST(rleFd, decodeManySegments) {
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  std::vector<uint8_t> input;
+  for (int i = 0; i < 5000; ++i) {
+    input.insert(input.end(), 1 + i % 9, (uint8_t)(i * 31));
+  }
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(input.data(), input.size(), &encoded));
+
+  ASSERT_EQ(RLE_OK,
+            RLE_decode_fd(encoded.data, encoded.size, fileno(file), NULL));
+
+  ASSERT_EQ(input, readAll(file));
+  free(encoded.data);
+  fclose(file);
+}
@@ -0,0 +1,123 @@
+/*!
+ * \file    tests_file.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of RLE coding of files within a memory budget.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tests_data.hpp"
+
+extern "C" {
+#include "rle.h"
+#include "rle_file.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static FILE *fileWith(const std::vector<uint8_t> &data);
+static std::vector<uint8_t> fileContent(FILE *file);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static FILE *fileWith(const std::vector<uint8_t> &data) {
+  FILE *file = tmpfile();
+  EXPECT_NE(nullptr, file);
+  EXPECT_EQ(data.size(), fwrite(data.data(), 1, data.size(), file));
+  rewind(file);
+  return file;
+}
+
+static std::vector<uint8_t> fileContent(FILE *file) {
+  std::vector<uint8_t> content;
+  uint8_t buffer[4096];
+  size_t n;
+
+  rewind(file);
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    content.insert(content.end(), buffer, buffer + n);
+  }
+  return content;
+}
+
+TEST(rleFile, wrongInputs) {
+  FILE *file = tmpfile();
+  RLE_FileOptions options = {RLE_file_min_memory() - 1};
+
+  ASSERT_EQ(RLE_ERROR, RLE_encode_file(NULL, file, NULL, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_file(file, NULL, NULL, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_file(file, file, &options, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_file(file, file, &options, NULL, NULL));
+  fclose(file);
+}
+
+TEST(rleFile, encodeMatchesEncode) {
+  std::vector<uint8_t> data = sampleData(300000, 5);
+  RLE_Data expected = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &expected));
+
+  for (uint64_t budget : {RLE_file_min_memory(), (uint64_t)100000,
+                          (uint64_t)RLE_FILE_DEFAULT_MEMORY}) {
+    FILE *in = fileWith(data);
+    FILE *out = tmpfile();
+    RLE_FileOptions options = {budget};
+    uint64_t read;
+    uint64_t written;
+
+    ASSERT_EQ(RLE_OK, RLE_encode_file(in, out, &options, &read, &written));
+    ASSERT_EQ(data.size(), read);
+    ASSERT_EQ(expected.size, written);
+    ASSERT_EQ(std::vector<uint8_t>(expected.data,
+                                   expected.data + expected.size),
+              fileContent(out))
+        << "budget " << budget;
+    fclose(in);
+    fclose(out);
+  }
+  free(expected.data);
+}
+
+TEST(rleFile, decodeRoundTrip) {
+  std::vector<uint8_t> data = sampleData(300000, 5);
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+
+  for (uint64_t budget : {RLE_file_min_memory(), (uint64_t)0}) {
+    FILE *in = fileWith(
+        std::vector<uint8_t>(encoded.data, encoded.data + encoded.size));
+    FILE *out = tmpfile();
+    RLE_FileOptions options = {budget};
+    uint64_t written;
+
+    ASSERT_EQ(RLE_OK, RLE_decode_file(in, out, &options, NULL, &written));
+    ASSERT_EQ(data.size(), written);
+    ASSERT_EQ(data, fileContent(out));
+    fclose(in);
+    fclose(out);
+  }
+  free(encoded.data);
+}
+
+TEST(rleFile, emptyAndMalformedInput) {
+  FILE *empty = tmpfile();
+  FILE *truncated = fileWith({3, 65, 0x85, 66});
+  FILE *out = tmpfile();
+
+  ASSERT_EQ(RLE_ERROR, RLE_encode_file(empty, out, NULL, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_file(empty, out, NULL, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_file(truncated, out, NULL, NULL, NULL));
+  fclose(empty);
+  fclose(truncated);
+  fclose(out);
+}
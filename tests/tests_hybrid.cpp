@@ -0,0 +1,136 @@
+/*!
+ * \file    tests_hybrid.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of hybrid RLE / bit-packing codec.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle_hybrid.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+
+TEST(rleHybrid, wrongInputs) {
+  RLE_Data data = {NULL, 0};
+  uint8_t in[] = {1, 2, 9};
+  uint8_t truncated[] = {3, 16, 0, 0, 0, 3};
+
+  ASSERT_EQ(RLE_ERROR, RLE_hybrid_encode(NULL, 0, 0, &data));
+  ASSERT_EQ(RLE_ERROR, RLE_hybrid_encode(in, sizeof(in), 3, &data));
+  ASSERT_EQ(RLE_ERROR, RLE_hybrid_encode(in, sizeof(in), 9, &data));
+  ASSERT_EQ(RLE_ERROR, RLE_hybrid_decode(truncated, sizeof(truncated), &data));
+  ASSERT_EQ(RLE_ERROR, RLE_hybrid_decode(in, sizeof(in), &data));
+}
+
+TEST(rleHybrid, bitWidth) {
+  uint8_t small[] = {0, 1, 0, 1};
+  uint8_t codes[] = {0, 5, 3};
+  uint8_t full[] = {128};
+
+  ASSERT_EQ(1, RLE_hybrid_bit_width(small, sizeof(small)));
+  ASSERT_EQ(3, RLE_hybrid_bit_width(codes, sizeof(codes)));
+  ASSERT_EQ(8, RLE_hybrid_bit_width(full, sizeof(full)));
+}
+
+TEST(rleHybrid, encodeRunAndPackedGroup) {
+  RLE_Data encoded = {NULL, 0};
+  std::vector<uint8_t> in(10, 4);
+  in.insert(in.end(), {1, 2, 3});
+  uint8_t expected[] = {3, 13, 0, 0, 0, 20, 4, 0x03, 0xd1, 0x00, 0x00};
+
+  ASSERT_EQ(RLE_OK, RLE_hybrid_encode(in.data(), in.size(), 3, &encoded));
+  ASSERT_EQ(std::vector<uint8_t>(expected, expected + sizeof(expected)),
+            std::vector<uint8_t>(encoded.data, encoded.data + encoded.size));
+
+  RLE_Data decoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_hybrid_decode(encoded.data, encoded.size, &decoded));
+  ASSERT_EQ(in, std::vector<uint8_t>(decoded.data,
+                                     decoded.data + decoded.size));
+  free(encoded.data);
+  free(decoded.data);
+}
+
+TEST(rleHybrid, longRunsAreRuns) {
+  RLE_Data encoded = {NULL, 0};
+  std::vector<uint8_t> in(1000, 2);
+  in.insert(in.end(), 1000, 1);
+
+  ASSERT_EQ(RLE_OK, RLE_hybrid_encode(in.data(), in.size(), 0, &encoded));
+
+  // header, two runs with two byte varint and the value
+  ASSERT_EQ(5u + 2 * 3, encoded.size);
+  ASSERT_EQ(2, encoded.data[0]);
+  free(encoded.data);
+}
+
+TEST(rleHybrid, overflowingVarint) {
+  // run of four ones with five byte header 8, the last byte sets bit 32
+  uint8_t overflow[] = {1, 4, 0, 0, 0, 0x88, 0x80, 0x80, 0x80, 0x10, 1};
+  uint8_t overlong[] = {1, 4, 0, 0, 0, 0x88, 0x80, 0x80, 0x80, 0x00, 1};
+  RLE_Data decoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_ERROR,
+            RLE_hybrid_decode(overflow, sizeof(overflow), &decoded));
+  ASSERT_EQ(RLE_OK, RLE_hybrid_decode(overlong, sizeof(overlong), &decoded));
+  ASSERT_EQ(std::vector<uint8_t>(4, 1),
+            std::vector<uint8_t>(decoded.data, decoded.data + decoded.size));
+  free(decoded.data);
+}
+
+TEST(rleHybrid, decodeLimits) {
+  // one run section of 0x7fffffff ones in 11 bytes
+  uint8_t bomb[] = {1, 0xff, 0xff, 0xff, 0x7f, 0xfe, 0xff, 0xff, 0xff, 0x0f, 1};
+  uint8_t data[] = {1, 100, 0, 0, 0, 200, 1, 1};
+  RLE_DecodeOptions ratio = {0, 1000};
+  RLE_DecodeOptions size = {99, 0};
+  RLE_Data decoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_ERROR_LIMIT,
+            RLE_hybrid_decode_ex(bomb, sizeof(bomb), &ratio, &decoded));
+  ASSERT_EQ(RLE_ERROR_LIMIT,
+            RLE_hybrid_decode_ex(data, sizeof(data), &size, &decoded));
+  size.maxOutputSize = 100;
+  ASSERT_EQ(RLE_OK, RLE_hybrid_decode_ex(data, sizeof(data), &size, &decoded));
+  ASSERT_EQ(std::vector<uint8_t>(100, 1),
+            std::vector<uint8_t>(decoded.data, decoded.data + decoded.size));
+  free(decoded.data);
+}
+
+TEST(rleHybrid, roundTripAllWidths) {
+  for (uint8_t width = 1; width <= 8; ++width) {
+    std::vector<uint8_t> in;
+    for (int i = 0; i < 3000; ++i) {
+      uint8_t value = (uint8_t)((i * 37 + i / 50) & ((1 << width) - 1));
+      in.insert(in.end(), i % 11 == 0 ? 20 : 1, value);
+    }
+    RLE_Data encoded = {NULL, 0};
+    RLE_Data decoded = {NULL, 0};
+
+    ASSERT_EQ(RLE_OK,
+              RLE_hybrid_encode(in.data(), in.size(), width, &encoded));
+    ASSERT_LT(encoded.size, 5 + in.size() * width / 8 + in.size() / 4);
+    ASSERT_EQ(RLE_OK,
+              RLE_hybrid_decode(encoded.data, encoded.size, &decoded));
+
+    ASSERT_EQ(in, std::vector<uint8_t>(decoded.data,
+                                       decoded.data + decoded.size));
+    free(encoded.data);
+    free(decoded.data);
+  }
+}
@@ -0,0 +1,244 @@
+/*!
+ * \file    tests_io.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of RLE coding between generic sources and sinks.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tests_data.hpp"
+
+extern "C" {
+#include "rle.h"
+#include "rle_io.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/*! Source returning the data one byte per read. */
+struct Bytes {
+  const std::vector<uint8_t> *data;
+  size_t pos;
+};
+
+/* Private macros ------------------------------------------------------------*/
+/*! Input file created in the working directory of the tests. */
+#define INPUT_PATH "rle_io_input.bin"
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> encoded(const std::vector<uint8_t> &data);
+static RLE_State readByte(void *context, const uint8_t **data, uint32_t *size,
+                          uint8_t *buffer, uint32_t capacity);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> encoded(const std::vector<uint8_t> &data) {
+  RLE_Data result = {NULL, 0};
+  EXPECT_EQ(RLE_OK, RLE_encode(data.data(), (uint32_t)data.size(), &result));
+  std::vector<uint8_t> out(result.data, result.data + result.size);
+  free(result.data);
+  return out;
+}
+
+static RLE_State readByte(void *context, const uint8_t **data, uint32_t *size,
+                          uint8_t *buffer, uint32_t capacity) {
+  Bytes *bytes = (Bytes *)context;
+
+  EXPECT_GT(capacity, 0u);
+  *size = 0;
+  if (bytes->pos < bytes->data->size()) {
+    buffer[0] = (*bytes->data)[bytes->pos++];
+    *size = 1;
+  }
+  *data = buffer;
+  return RLE_OK;
+}
+
+TEST(rleIo, wrongInputs) {
+  RLE_Source source;
+  RLE_Sink sink;
+  RLE_Data result = {NULL, 0};
+
+  ASSERT_EQ(RLE_ERROR, RLE_source_memory(NULL, 1, &source));
+  ASSERT_EQ(RLE_ERROR, RLE_source_file(NULL, &source));
+  ASSERT_EQ(RLE_ERROR, RLE_sink_memory(NULL, &sink));
+  ASSERT_EQ(RLE_ERROR, RLE_sink_file(NULL, &sink));
+
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_io(NULL, &sink, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_io(NULL, &sink, NULL, NULL));
+  RLE_sink_close(&sink);
+  free(result.data);
+}
+
+TEST(rleIo, emptySource) {
+  RLE_Source source;
+  RLE_Sink sink;
+  RLE_Data result = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_source_memory(NULL, 0, &source));
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_io(&source, &sink, NULL, NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_io(&source, &sink, NULL, NULL));
+  ASSERT_EQ(0u, result.size);
+  RLE_source_close(&source);
+  RLE_sink_close(&sink);
+  free(result.data);
+}
+
+TEST(rleIo, memoryRoundTrip) {
+  for (uint32_t size :
+       {1u, 1000u, RLE_IO_CHUNK_SIZE, 3 * RLE_IO_CHUNK_SIZE + 7}) {
+    std::vector<uint8_t> data = sampleData(size, 11);
+    RLE_Source source;
+    RLE_Sink sink;
+    RLE_Data compressed = {NULL, 0};
+    RLE_Data decompressed = {NULL, 0};
+    uint64_t read = 0;
+    uint64_t written = 0;
+
+    ASSERT_EQ(RLE_OK, RLE_source_memory(data.data(), size, &source));
+    ASSERT_EQ(RLE_OK, RLE_sink_memory(&compressed, &sink));
+    ASSERT_EQ(RLE_OK, RLE_encode_io(&source, &sink, &read, &written));
+    RLE_source_close(&source);
+    RLE_sink_close(&sink);
+    ASSERT_EQ(size, read);
+    ASSERT_EQ(compressed.size, written);
+    ASSERT_EQ(encoded(data), std::vector<uint8_t>(compressed.data,
+                                                  compressed.data + written));
+
+    ASSERT_EQ(RLE_OK,
+              RLE_source_memory(compressed.data, compressed.size, &source));
+    ASSERT_EQ(RLE_OK, RLE_sink_memory(&decompressed, &sink));
+    ASSERT_EQ(RLE_OK, RLE_decode_io(&source, &sink, &read, &written));
+    RLE_source_close(&source);
+    RLE_sink_close(&sink);
+    ASSERT_EQ(compressed.size, read);
+    ASSERT_EQ(size, written);
+    ASSERT_EQ(data, std::vector<uint8_t>(decompressed.data,
+                                         decompressed.data + written));
+    free(compressed.data);
+    free(decompressed.data);
+  }
+}
+
+TEST(rleIo, fileRoundTrip) {
+  std::vector<uint8_t> data = sampleData(200000, 11);
+  FILE *in = tmpfile();
+  FILE *out = tmpfile();
+  RLE_Source source;
+  RLE_Sink sink;
+  RLE_Data result = {NULL, 0};
+
+  ASSERT_NE(nullptr, in);
+  ASSERT_NE(nullptr, out);
+  ASSERT_EQ(data.size(), fwrite(data.data(), 1, data.size(), in));
+  rewind(in);
+  ASSERT_EQ(RLE_OK, RLE_source_file(in, &source));
+  ASSERT_EQ(RLE_OK, RLE_sink_file(out, &sink));
+  ASSERT_EQ(RLE_OK, RLE_encode_io(&source, &sink, NULL, NULL));
+  fflush(out);
+
+  rewind(out);
+  ASSERT_EQ(RLE_OK, RLE_source_file(out, &source));
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_OK, RLE_decode_io(&source, &sink, NULL, NULL));
+  RLE_sink_close(&sink);
+  ASSERT_EQ(data, std::vector<uint8_t>(result.data, result.data + result.size));
+  free(result.data);
+  fclose(in);
+  fclose(out);
+}
+
+TEST(rleIo, customSource) {
+  std::vector<uint8_t> data = sampleData(5000, 11);
+  std::vector<uint8_t> compressed = encoded(data);
+  Bytes bytes = {&data, 0};
+  RLE_Source source = {readByte, NULL, &bytes};
+  RLE_Sink sink;
+  RLE_Data result = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_OK, RLE_encode_io(&source, &sink, NULL, NULL));
+  RLE_sink_close(&sink);
+  ASSERT_EQ(compressed,
+            std::vector<uint8_t>(result.data, result.data + result.size));
+  free(result.data);
+
+  // the decoder resumes tokens split between the reads
+  result = {NULL, 0};
+  bytes = {&compressed, 0};
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_OK, RLE_decode_io(&source, &sink, NULL, NULL));
+  RLE_sink_close(&sink);
+  ASSERT_EQ(data, std::vector<uint8_t>(result.data, result.data + result.size));
+  free(result.data);
+}
+
+TEST(rleIo, decodeMalformed) {
+  std::vector<uint8_t> malformed = {5, 65, 0x83, 66};
+  RLE_Source source;
+  RLE_Sink sink;
+  RLE_Data result = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK,
+            RLE_source_memory(malformed.data(), malformed.size(), &source));
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_io(&source, &sink, NULL, NULL));
+  RLE_source_close(&source);
+  RLE_sink_close(&sink);
+  free(result.data);
+}
+
+#ifndef _WIN32
+TEST(rleIo, descriptorAndMapping) {
+  std::vector<uint8_t> data = sampleData(100000, 11);
+  RLE_Source source;
+  RLE_Sink sink;
+  RLE_Data result = {NULL, 0};
+
+  int fd = open(INPUT_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(RLE_OK, RLE_source_memory(data.data(), data.size(), &source));
+  ASSERT_EQ(RLE_OK, RLE_sink_fd(fd, &sink));
+  ASSERT_EQ(RLE_OK, RLE_encode_io(&source, &sink, NULL, NULL));
+  RLE_source_close(&source);
+  close(fd);
+
+  fd = open(INPUT_PATH, O_RDONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(RLE_OK, RLE_source_fd(fd, &source));
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_OK, RLE_decode_io(&source, &sink, NULL, NULL));
+  RLE_sink_close(&sink);
+  close(fd);
+  ASSERT_EQ(data, std::vector<uint8_t>(result.data, result.data + result.size));
+  free(result.data);
+
+  ASSERT_EQ(RLE_OK, RLE_source_mmap(INPUT_PATH, &source));
+  ASSERT_EQ(RLE_OK, RLE_sink_memory(&result, &sink));
+  ASSERT_EQ(RLE_OK, RLE_decode_io(&source, &sink, NULL, NULL));
+  RLE_source_close(&source);
+  RLE_sink_close(&sink);
+  ASSERT_EQ(data, std::vector<uint8_t>(result.data, result.data + result.size));
+  free(result.data);
+
+  remove(INPUT_PATH);
+  ASSERT_EQ(RLE_ERROR, RLE_source_mmap(INPUT_PATH, &source));
+}
+#endif
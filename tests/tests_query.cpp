@@ -0,0 +1,188 @@
+/*!
+ * \file    tests_query.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of queries evaluated directly on RLE encoded data.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_query.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+
+TEST(rleQuery, wrongInputs) {
+  uint8_t malformed[] = {3, 65, 0x84, 66};
+  uint64_t value = 42;
+  uint64_t histogram[256];
+
+  ASSERT_EQ(RLE_ERROR, RLE_count(NULL, 0, 65, &value));
+  ASSERT_EQ(RLE_ERROR, RLE_sum(malformed, sizeof(malformed), &value));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_histogram(malformed, sizeof(malformed), histogram));
+  ASSERT_EQ(RLE_ERROR, RLE_count(malformed, sizeof(malformed), 65, &value));
+  ASSERT_EQ(42u, value);
+}
+
+TEST(rleQuery, countAndSum) {
+  uint8_t data[] = {127, 65, 0x83, 65, 66, 67, 10, 1};
+  uint64_t count = 0;
+  uint64_t sum = 0;
+
+  ASSERT_EQ(RLE_OK, RLE_count(data, sizeof(data), 65, &count));
+  ASSERT_EQ(128u, count);
+  ASSERT_EQ(RLE_OK, RLE_count(data, sizeof(data), 1, &count));
+  ASSERT_EQ(10u, count);
+  ASSERT_EQ(RLE_OK, RLE_sum(data, sizeof(data), &sum));
+  ASSERT_EQ(127u * 65 + 65 + 66 + 67 + 10, sum);
+}
+
+TEST(rleQuery, histogram) {
+  uint8_t data[] = {5, 0, 0x82, 7, 0, 2, 255};
+  uint64_t histogram[256];
+
+  ASSERT_EQ(RLE_OK, RLE_histogram(data, sizeof(data), histogram));
+  ASSERT_EQ(6u, histogram[0]);
+  ASSERT_EQ(1u, histogram[7]);
+  ASSERT_EQ(2u, histogram[255]);
+  ASSERT_EQ(0u, histogram[1]);
+}
+
+TEST(rleQuery, find) {
+  uint8_t data[] = {100, 65, 0x83, 66, 67, 68, 3, 69};
+  uint64_t position = 0;
+
+  ASSERT_EQ(RLE_OK, RLE_find(data, sizeof(data), 65, &position));
+  ASSERT_EQ(0u, position);
+  ASSERT_EQ(RLE_OK, RLE_find(data, sizeof(data), 67, &position));
+  ASSERT_EQ(101u, position);
+  ASSERT_EQ(RLE_OK, RLE_find(data, sizeof(data), 69, &position));
+  ASSERT_EQ(103u, position);
+  ASSERT_EQ(RLE_OK, RLE_find(data, sizeof(data), 70, &position));
+  ASSERT_EQ(106u, position);
+}
+
+TEST(rleQuery, matchesDecodedData) {
+  std::vector<uint8_t> input;
+  for (int i = 0; i < 2000; ++i) {
+    input.insert(input.end(), 1 + (i * 13) % 7, (uint8_t)((i * i) % 17));
+  }
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(input.data(), input.size(), &encoded));
+
+  uint64_t histogram[256];
+  uint64_t expected[256] = {0};
+  uint64_t sum = 0;
+  for (uint8_t b : input) {
+    expected[b]++;
+    sum += b;
+  }
+  ASSERT_EQ(RLE_OK, RLE_histogram(encoded.data, encoded.size, histogram));
+  for (int i = 0; i < 256; ++i) {
+    ASSERT_EQ(expected[i], histogram[i]);
+  }
+
+  uint64_t result = 0;
+  ASSERT_EQ(RLE_OK, RLE_sum(encoded.data, encoded.size, &result));
+  ASSERT_EQ(sum, result);
+  free(encoded.data);
+}
+
+TEST(rleQuery, equalIgnoresTokenization) {
+  uint8_t first[] = {127, 65, 9, 65, 0x82, 66, 67};
+  uint8_t second[] = {100, 65, 0x82, 65, 65, 34, 65, 0x81, 66, 0x81, 67};
+  uint8_t third[] = {127, 65, 9, 65, 0x82, 66, 68};
+  bool equal = false;
+
+  ASSERT_EQ(RLE_OK, RLE_equal(first, sizeof(first), second, sizeof(second),
+                              &equal));
+  ASSERT_TRUE(equal);
+  ASSERT_EQ(RLE_OK,
+            RLE_equal(first, sizeof(first), third, sizeof(third), &equal));
+  ASSERT_FALSE(equal);
+  ASSERT_EQ(RLE_ERROR, RLE_equal(first, sizeof(first), third, 3, &equal));
+}
+
+TEST(rleQuery, firstDifference) {
+  uint8_t first[] = {100, 65, 0x83, 66, 67, 68};
+  uint8_t second[] = {50, 65, 0x81, 69, 52, 65};
+  uint8_t prefix[] = {100, 65};
+  uint64_t offset = 0;
+
+  ASSERT_EQ(RLE_OK, RLE_first_difference(first, sizeof(first), second,
+                                         sizeof(second), &offset));
+  ASSERT_EQ(50u, offset);
+  ASSERT_EQ(RLE_OK, RLE_first_difference(first, sizeof(first), prefix,
+                                         sizeof(prefix), &offset));
+  ASSERT_EQ(100u, offset);
+  ASSERT_EQ(RLE_OK, RLE_first_difference(first, sizeof(first), first,
+                                         sizeof(first), &offset));
+  ASSERT_EQ(UINT64_MAX, offset);
+}
+
+TEST(rleQuery, sizeMismatch) {
+  uint8_t shorter[] = {100, 65};
+  uint8_t longer[] = {60, 65, 90, 65, 0x82, 1, 2};
+  uint8_t malformed[] = {100, 65, 50, 66, 9};
+  RLE_Range *ranges = NULL;
+  uint32_t count = 0;
+  uint64_t offset = 0;
+  bool equal = true;
+
+  // the walk stops at the end of the shorter data, the tail is not read
+  ASSERT_EQ(RLE_OK, RLE_equal(shorter, sizeof(shorter), malformed,
+                              sizeof(malformed), &equal));
+  ASSERT_FALSE(equal);
+  ASSERT_EQ(RLE_OK, RLE_first_difference(shorter, sizeof(shorter), malformed,
+                                         sizeof(malformed), &offset));
+  ASSERT_EQ(100u, offset);
+  ASSERT_EQ(RLE_ERROR, RLE_diff(shorter, sizeof(shorter), malformed,
+                                sizeof(malformed), &ranges, &count));
+
+  ASSERT_EQ(RLE_OK, RLE_diff(longer, sizeof(longer), shorter, sizeof(shorter),
+                             &ranges, &count));
+  ASSERT_EQ(1u, count);
+  ASSERT_EQ(100u, ranges[0].offset);
+  ASSERT_EQ(52u, ranges[0].length);
+  free(ranges);
+}
+
+TEST(rleQuery, diffRanges) {
+  uint8_t first[] = {10, 65, 0x84, 1, 2, 3, 4, 10, 66};
+  uint8_t second[] = {5, 65, 5, 67, 0x84, 1, 9, 9, 4, 12, 66};
+  RLE_Range *ranges = NULL;
+  uint32_t count = 0;
+
+  ASSERT_EQ(RLE_OK, RLE_diff(first, sizeof(first), second, sizeof(second),
+                             &ranges, &count));
+
+  ASSERT_EQ(3u, count);
+  ASSERT_EQ(5u, ranges[0].offset);
+  ASSERT_EQ(5u, ranges[0].length);
+  ASSERT_EQ(11u, ranges[1].offset);
+  ASSERT_EQ(2u, ranges[1].length);
+  ASSERT_EQ(24u, ranges[2].offset);
+  ASSERT_EQ(2u, ranges[2].length);
+  free(ranges);
+
+  ASSERT_EQ(RLE_OK, RLE_diff(first, sizeof(first), first, sizeof(first),
+                             &ranges, &count));
+  ASSERT_EQ(0u, count);
+  ASSERT_EQ(NULL, ranges);
+}
@@ -0,0 +1,309 @@
+/*!
+ * \file    tests_stream.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of resumable RLE encoder and decoder.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_stream.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/*! Tiles collected by the consumer of RLE_decode_cb. */
+struct Tiles {
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> sizes;
+};
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> sampleData(size_t size, unsigned seed);
+static std::vector<uint8_t> encodeInPieces(const std::vector<uint8_t> &data,
+                                           size_t piece);
+static bool collectTile(void *context, const uint8_t *data, uint32_t size);
+static bool stopAfterTwoTiles(void *context, const uint8_t *data,
+                              uint32_t size);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> sampleData(size_t size, unsigned seed) {
+  std::vector<uint8_t> data;
+  srand(seed);
+  while (data.size() < size) {
+    uint8_t value = (uint8_t)(rand() % 3);
+    size_t length = rand() % 4 == 0 ? rand() % 300 + 1 : rand() % 3 + 1;
+    data.insert(data.end(), length, value);
+  }
+  data.resize(size);
+  return data;
+}
+
+static std::vector<uint8_t> encodeInPieces(const std::vector<uint8_t> &data,
+                                           size_t piece) {
+  RLE_Encoder encoder;
+  std::vector<uint8_t> result;
+  std::vector<uint8_t> out(RLE_encoder_bound(piece));
+  uint32_t written;
+
+  RLE_encoder_init(&encoder);
+  for (size_t pos = 0; pos < data.size(); pos += piece) {
+    uint32_t n = data.size() - pos < piece ? data.size() - pos : piece;
+    EXPECT_EQ(RLE_OK,
+              RLE_encoder_feed(&encoder, &data[pos], n, out.data(), &written));
+    result.insert(result.end(), out.begin(), out.begin() + written);
+  }
+  EXPECT_EQ(RLE_OK, RLE_encoder_finish(&encoder, out.data(), &written));
+  result.insert(result.end(), out.begin(), out.begin() + written);
+  return result;
+}
+
+static bool collectTile(void *context, const uint8_t *data, uint32_t size) {
+  Tiles *tiles = (Tiles *)context;
+  tiles->sizes.push_back(size);
+  tiles->data.insert(tiles->data.end(), data, data + size);
+  return true;
+}
+
+static bool stopAfterTwoTiles(void *context, const uint8_t *data,
+                              uint32_t size) {
+  (void)data;
+  (void)size;
+  int *calls = (int *)context;
+  return ++*calls < 2;
+}
+
+TEST(rleStream, encoderWrongInputs) {
+  RLE_Encoder encoder;
+  uint8_t out[1024];
+  uint32_t written;
+
+  RLE_encoder_init(&encoder);
+  ASSERT_EQ(RLE_ERROR, RLE_encoder_feed(NULL, out, 1, out, &written));
+  ASSERT_EQ(RLE_ERROR, RLE_encoder_feed(&encoder, NULL, 1, out, &written));
+  ASSERT_EQ(RLE_ERROR, RLE_encoder_feed(&encoder, out, 1, NULL, &written));
+  ASSERT_EQ(RLE_ERROR, RLE_encoder_finish(&encoder, out, NULL));
+  ASSERT_EQ(RLE_OK, RLE_encoder_feed(&encoder, NULL, 0, out, &written));
+  ASSERT_EQ(0u, written);
+}
+
+TEST(rleStream, encoderMatchesEncode) {
+  std::vector<uint8_t> data = sampleData(20000, 7);
+  RLE_Data expected = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &expected));
+
+  for (size_t piece : {1, 2, 3, 5, 64, 127, 128, 129, 1000, 20000}) {
+    std::vector<uint8_t> encoded = encodeInPieces(data, piece);
+    ASSERT_EQ(std::vector<uint8_t>(expected.data,
+                                   expected.data + expected.size),
+              encoded)
+        << "piece " << piece;
+  }
+  free(expected.data);
+}
+
+TEST(rleStream, encoderHoldsUndecidedToken) {
+  RLE_Encoder encoder;
+  uint8_t out[1024];
+  uint8_t in[] = {1, 1, 1};
+  uint32_t written;
+
+  RLE_encoder_init(&encoder);
+  ASSERT_EQ(RLE_OK, RLE_encoder_feed(&encoder, in, sizeof(in), out, &written));
+  ASSERT_EQ(0u, written);
+  ASSERT_EQ(RLE_OK, RLE_encoder_feed(&encoder, in, sizeof(in), out, &written));
+  ASSERT_EQ(0u, written);
+  ASSERT_EQ(RLE_OK, RLE_encoder_finish(&encoder, out, &written));
+  ASSERT_EQ(2u, written);
+  ASSERT_EQ(6, out[0]);
+  ASSERT_EQ(1, out[1]);
+}
+
+TEST(rleStream, decoderInPieces) {
+  std::vector<uint8_t> data = sampleData(20000, 11);
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+
+  for (uint32_t piece : {1u, 2u, 7u, 128u, 4096u}) {
+    RLE_Decoder decoder;
+    std::vector<uint8_t> decoded;
+    std::vector<uint8_t> out(piece);
+    uint32_t produced;
+
+    RLE_decoder_init(&decoder);
+    for (uint32_t pos = 0; pos < encoded.size; pos += piece) {
+      const uint8_t *in = &encoded.data[pos];
+      uint32_t len = encoded.size - pos < piece ? encoded.size - pos : piece;
+      do {
+        ASSERT_EQ(RLE_OK, RLE_decoder_feed(&decoder, &in, &len, out.data(),
+                                           piece, &produced));
+        decoded.insert(decoded.end(), out.begin(), out.begin() + produced);
+      } while (produced == piece);
+      ASSERT_EQ(0u, len);
+    }
+    ASSERT_EQ(RLE_OK, RLE_decoder_finish(&decoder));
+    ASSERT_EQ(data, decoded) << "piece " << piece;
+  }
+  free(encoded.data);
+}
+
+TEST(rleStream, storedBlocks) {
+  std::vector<uint8_t> data = sampleData(30000, 13);
+  srand(17);
+  for (size_t pos = 0; pos + 6000 < data.size(); pos += 9000) {
+    for (size_t i = pos; i < pos + 6000; ++i) {
+      data[i] = (uint8_t)rand();
+    }
+  }
+  RLE_Data expected = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &expected));
+
+  for (size_t piece : {1, 5, 127, 4096, 5000, 30000}) {
+    std::vector<uint8_t> encoded = encodeInPieces(data, piece);
+    ASSERT_EQ(std::vector<uint8_t>(expected.data,
+                                   expected.data + expected.size),
+              encoded)
+        << "piece " << piece;
+
+    RLE_Decoder decoder;
+    std::vector<uint8_t> decoded;
+    std::vector<uint8_t> out(piece);
+    uint32_t produced;
+
+    RLE_decoder_init(&decoder);
+    for (size_t pos = 0; pos < encoded.size(); pos += piece) {
+      const uint8_t *in = &encoded[pos];
+      uint32_t len = encoded.size() - pos < piece ? encoded.size() - pos
+                                                  : piece;
+      do {
+        ASSERT_EQ(RLE_OK, RLE_decoder_feed(&decoder, &in, &len, out.data(),
+                                           piece, &produced));
+        decoded.insert(decoded.end(), out.begin(), out.begin() + produced);
+      } while (produced == piece);
+    }
+    ASSERT_EQ(RLE_OK, RLE_decoder_finish(&decoder));
+    ASSERT_EQ(data, decoded) << "piece " << piece;
+  }
+  free(expected.data);
+}
+
+TEST(rleStream, decoderMalformedTokens) {
+  RLE_Decoder decoder;
+  uint8_t out[16];
+  uint32_t produced;
+  uint8_t zeroCount[] = {2, 65, 0, 66};
+  uint8_t truncated[] = {2, 65, 0x83, 66};
+  const uint8_t *in = zeroCount;
+  uint32_t len = sizeof(zeroCount);
+
+  RLE_decoder_init(&decoder);
+  ASSERT_EQ(RLE_ERROR,
+            RLE_decoder_feed(&decoder, &in, &len, out, sizeof(out), &produced));
+
+  in = truncated;
+  len = sizeof(truncated);
+  RLE_decoder_init(&decoder);
+  ASSERT_EQ(RLE_OK,
+            RLE_decoder_feed(&decoder, &in, &len, out, sizeof(out), &produced));
+  ASSERT_EQ(3u, produced);
+  ASSERT_EQ(RLE_ERROR, RLE_decoder_finish(&decoder));
+
+  uint8_t zeroStored[] = {0x80, 0, 0, 66};
+  in = zeroStored;
+  len = sizeof(zeroStored);
+  RLE_decoder_init(&decoder);
+  ASSERT_EQ(RLE_ERROR,
+            RLE_decoder_feed(&decoder, &in, &len, out, sizeof(out), &produced));
+
+  uint8_t shortStored[] = {0x80, 1};
+  in = shortStored;
+  len = sizeof(shortStored);
+  RLE_decoder_init(&decoder);
+  ASSERT_EQ(RLE_OK,
+            RLE_decoder_feed(&decoder, &in, &len, out, sizeof(out), &produced));
+  ASSERT_EQ(RLE_ERROR, RLE_decoder_finish(&decoder));
+}
+
+TEST(rleStream, decodeCallbackWrongInputs) {
+  uint8_t in[] = {3, 65};
+  uint8_t tile[4];
+  Tiles tiles;
+
+  ASSERT_EQ(RLE_ERROR, RLE_decode_cb(NULL, 2, NULL, 0, collectTile, &tiles,
+                                     NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_cb(in, 0, NULL, 0, collectTile, &tiles,
+                                     NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_cb(in, 2, tile, 0, collectTile, &tiles,
+                                     NULL));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_cb(in, 2, NULL, 0, NULL, NULL, NULL));
+  ASSERT_TRUE(tiles.sizes.empty());
+}
+
+TEST(rleStream, decodeCallbackTiles) {
+  std::vector<uint8_t> data = sampleData(200000, 17);
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+
+  for (uint32_t size : {1u, 100u, 4096u, 0u}) {
+    std::vector<uint8_t> tile(size);
+    Tiles tiles;
+    uint64_t decoded;
+
+    ASSERT_EQ(RLE_OK, RLE_decode_cb(encoded.data, encoded.size,
+                                    size > 0 ? tile.data() : NULL, size,
+                                    collectTile, &tiles, &decoded));
+    ASSERT_EQ(data.size(), decoded);
+    ASSERT_EQ(data, tiles.data);
+
+    uint32_t full = size > 0 ? size : RLE_DECODE_TILE_SIZE;
+    for (size_t k = 0; k + 1 < tiles.sizes.size(); ++k) {
+      ASSERT_EQ(full, tiles.sizes[k]);
+    }
+    ASSERT_EQ(data.size() % full == 0 ? full : data.size() % full,
+              tiles.sizes.back());
+  }
+  free(encoded.data);
+}
+
+TEST(rleStream, decodeCallbackStop) {
+  std::vector<uint8_t> data = sampleData(10000, 19);
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &encoded));
+
+  // the consumer stops decoding, the malformed rest is never reached
+  encoded.data[encoded.size - 1] = 0x80;
+  uint8_t tile[256];
+  int calls = 0;
+  uint64_t decoded;
+  ASSERT_EQ(RLE_OK, RLE_decode_cb(encoded.data, encoded.size, tile,
+                                  sizeof(tile), stopAfterTwoTiles, &calls,
+                                  &decoded));
+  ASSERT_EQ(2, calls);
+  ASSERT_EQ(2 * sizeof(tile), decoded);
+  free(encoded.data);
+}
+
+TEST(rleStream, decodeCallbackMalformed) {
+  uint8_t truncated[] = {5, 65, 0x83, 66};
+  uint8_t zeroCount[] = {5, 65, 0, 66};
+  Tiles tiles;
+  uint64_t decoded;
+
+  ASSERT_EQ(RLE_ERROR, RLE_decode_cb(truncated, sizeof(truncated), NULL, 0,
+                                     collectTile, &tiles, &decoded));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_cb(zeroCount, sizeof(zeroCount), NULL, 0,
+                                     collectTile, &tiles, &decoded));
+}
@@ -0,0 +1,201 @@
+/*!
+ * \file    tests_transform.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of RLE coding with reversible pre-transforms.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rle.h"
+#include "rle_transform.h"
+}
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static std::vector<uint8_t> counter(size_t count, size_t width, uint64_t first,
+                                    uint64_t step);
+
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+static std::vector<uint8_t> counter(size_t count, size_t width, uint64_t first,
+                                    uint64_t step) {
+  std::vector<uint8_t> data;
+  uint64_t value = first;
+  for (size_t k = 0; k < count; k++) {
+    for (size_t b = 0; b < width; b++) {
+      data.push_back((uint8_t)(value >> (8 * b)));
+    }
+    value += step;
+  }
+  return data;
+}
+
+TEST(rleTransform, deltaWrongInputs) {
+  RLE_Data result = {NULL, 0};
+  uint8_t in[] = {1, 2, 3, 4};
+  RLE_DeltaOptions options = {4, 1};
+  RLE_DeltaOptions badWidth = {3, 1};
+  RLE_DeltaOptions badOrder = {4, 3};
+
+  ASSERT_EQ(RLE_ERROR, RLE_encode_delta(NULL, 4, &options, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_delta(in, 0, &options, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_delta(in, 4, NULL, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_delta(in, 4, &badWidth, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_delta(in, 4, &badOrder, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_delta(in, 4, &badWidth, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_delta(in, 0, &options, &result));
+}
+
+TEST(rleTransform, deltaOfDeltaCompressesCounter) {
+  // Second differences of the counter are zero.
+  std::vector<uint8_t> data = counter(10000, 4, 1000, 3);
+  RLE_DeltaOptions options = {4, 2};
+  RLE_Data encoded = {NULL, 0};
+  RLE_Data plain = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK,
+            RLE_encode_delta(data.data(), data.size(), &options, &encoded));
+  ASSERT_EQ(RLE_OK, RLE_encode(data.data(), data.size(), &plain));
+  ASSERT_LT(encoded.size * 10, plain.size);
+  free(plain.data);
+
+  RLE_Data decoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK,
+            RLE_decode_delta(encoded.data, encoded.size, &options, &decoded));
+  ASSERT_EQ(data, std::vector<uint8_t>(decoded.data,
+                                       decoded.data + decoded.size));
+  free(encoded.data);
+  free(decoded.data);
+}
+
+TEST(rleTransform, deltaRoundTrip) {
+  for (uint8_t width : {1, 2, 4, 8}) {
+    for (uint8_t order : {1, 2}) {
+      // Odd length leaves trailing bytes outside of whole elements.
+      std::vector<uint8_t> data = counter(3001, width, ~0ull - 5, 1);
+      data.push_back(0x55);
+      RLE_DeltaOptions options = {width, order};
+      RLE_Data encoded = {NULL, 0};
+      RLE_Data decoded = {NULL, 0};
+
+      ASSERT_EQ(RLE_OK,
+                RLE_encode_delta(data.data(), data.size(), &options, &encoded));
+      ASSERT_EQ(RLE_OK, RLE_decode_delta(encoded.data, encoded.size, &options,
+                                         &decoded));
+      ASSERT_EQ(data, std::vector<uint8_t>(decoded.data,
+                                           decoded.data + decoded.size))
+          << "width " << (int)width << " order " << (int)order;
+      free(encoded.data);
+      free(decoded.data);
+    }
+  }
+}
+
+TEST(rleTransform, deltaStoresPlainRle) {
+  uint8_t in[] = {5, 6, 7, 8, 9};
+  uint8_t expected[] = {0x81, 5, 4, 1};
+  RLE_DeltaOptions options = {1, 1};
+  RLE_Data encoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_encode_delta(in, sizeof(in), &options, &encoded));
+  ASSERT_EQ(sizeof(expected), encoded.size);
+  ASSERT_EQ(0, memcmp(expected, encoded.data, sizeof(expected)));
+  free(encoded.data);
+}
+
+TEST(rleTransform, pipelineWrongInputs) {
+  RLE_Data result = {NULL, 0};
+  uint8_t in[] = {1, 2, 3, 4};
+  RLE_Pipeline pipeline = {{{RLE_STAGE_XOR, 3, 0}}, 1};
+  RLE_Pipeline tooLong = {{}, RLE_PIPELINE_MAX_STAGES + 1};
+  uint8_t unknownStage[] = {1, 9, 1, 0, 1, 0};
+  uint8_t truncatedHeader[] = {2, RLE_STAGE_MTF, 1, 0};
+  uint8_t noTokens[] = {1, RLE_STAGE_MTF, 1, 0};
+
+  ASSERT_EQ(RLE_ERROR, RLE_encode_pipeline(in, sizeof(in), NULL, &result));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_encode_pipeline(in, sizeof(in), &pipeline, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_encode_pipeline(in, sizeof(in), &tooLong, &result));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_pipeline(unknownStage, sizeof(unknownStage),
+                                           &result));
+  ASSERT_EQ(RLE_ERROR, RLE_decode_pipeline(truncatedHeader,
+                                           sizeof(truncatedHeader), &result));
+  ASSERT_EQ(RLE_ERROR,
+            RLE_decode_pipeline(noTokens, sizeof(noTokens), &result));
+}
+
+TEST(rleTransform, pipelineStoresStages) {
+  uint8_t in[] = {7, 7, 7, 7};
+  RLE_Pipeline pipeline = {
+      {{RLE_STAGE_SHUFFLE, 2, 0}, {RLE_STAGE_DELTA, 1, 1}}, 2};
+  uint8_t expected[] = {2,    RLE_STAGE_SHUFFLE, 2, 0, RLE_STAGE_DELTA, 1, 1,
+                        0x81, 7,                 3, 0};
+  RLE_Data encoded = {NULL, 0};
+  RLE_Pipeline read;
+
+  ASSERT_EQ(RLE_OK, RLE_encode_pipeline(in, sizeof(in), &pipeline, &encoded));
+  ASSERT_EQ(sizeof(expected), encoded.size);
+  ASSERT_EQ(0, memcmp(expected, encoded.data, sizeof(expected)));
+
+  ASSERT_EQ(RLE_OK, RLE_pipeline_read(encoded.data, encoded.size, &read));
+  ASSERT_EQ(2, read.count);
+  ASSERT_EQ(RLE_STAGE_DELTA, read.stages[1].type);
+  ASSERT_EQ(1, read.stages[1].order);
+  free(encoded.data);
+}
+
+TEST(rleTransform, pipelineRoundTrip) {
+  // Spans several tiles and ends with a partial element.
+  std::vector<uint8_t> data = counter(5000, 8, 1ull << 40, 1000);
+  data.push_back(3);
+  RLE_Pipeline pipelines[] = {
+      {{}, 0},
+      {{{RLE_STAGE_DELTA, 8, 1}, {RLE_STAGE_SHUFFLE, 8, 0}}, 2},
+      {{{RLE_STAGE_XOR, 4, 0}, {RLE_STAGE_MTF, 0, 0}}, 2},
+      {{{RLE_STAGE_SHUFFLE, 2, 0},
+        {RLE_STAGE_DELTA, 2, 2},
+        {RLE_STAGE_XOR, 1, 0},
+        {RLE_STAGE_MTF, 1, 0}},
+       4},
+  };
+
+  for (const RLE_Pipeline &pipeline : pipelines) {
+    RLE_Data encoded = {NULL, 0};
+    RLE_Data decoded = {NULL, 0};
+
+    ASSERT_EQ(RLE_OK, RLE_encode_pipeline(data.data(), data.size(), &pipeline,
+                                          &encoded));
+    ASSERT_EQ(RLE_OK,
+              RLE_decode_pipeline(encoded.data, encoded.size, &decoded));
+    ASSERT_EQ(data, std::vector<uint8_t>(decoded.data,
+                                         decoded.data + decoded.size))
+        << "stages " << (int)pipeline.count;
+    free(encoded.data);
+    free(decoded.data);
+  }
+}
+
+TEST(rleTransform, pipelineShuffleDeltaCompresses) {
+  // Delta of the counter is constant, shuffled its zero high bytes form runs.
+  std::vector<uint8_t> data = counter(4096, 8, 1ull << 40, 1000);
+  RLE_Pipeline pipeline = {
+      {{RLE_STAGE_DELTA, 8, 1}, {RLE_STAGE_SHUFFLE, 8, 0}}, 2};
+  RLE_Data encoded = {NULL, 0};
+
+  ASSERT_EQ(RLE_OK, RLE_encode_pipeline(data.data(), data.size(), &pipeline,
+                                        &encoded));
+  ASSERT_LT(encoded.size, data.size() / 50);
+  free(encoded.data);
+}
@@ -0,0 +1,107 @@
+/*!
+ * \file    tests_view.cpp
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Unit tests of the lazy C++ view over encoded data.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rle.hpp"
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+/* Exported functions definitions --------------------------------------------*/
+/* Private function definitions ----------------------------------------------*/
+
+TEST(rleView, emptyView) {
+  rle::view view;
+  ASSERT_TRUE(view.begin() == view.end());
+  ASSERT_TRUE(view.runs().begin() == view.runs().end());
+}
+
+TEST(rleView, decodedBytes) {
+  uint8_t data[] = {5, 65, 0x83, 66, 67, 68, 2, 65};
+  std::vector<uint8_t> expected = {65, 65, 65, 65, 65, 66, 67, 68, 65, 65};
+  rle::view view(data, sizeof(data));
+
+  std::vector<uint8_t> decoded(view.begin(), view.end());
+
+  ASSERT_EQ(expected, decoded);
+  ASSERT_EQ(10, std::distance(view.begin(), view.end()));
+  ASSERT_EQ(7, std::count(view.begin(), view.end(), 65));
+  ASSERT_EQ(5, std::distance(view.begin(),
+                             std::find(view.begin(), view.end(), 66)));
+}
+
+TEST(rleView, runsMergeAdjacentTokens) {
+  uint8_t data[] = {127, 65, 9, 65, 0x83, 65, 66, 66, 3, 66};
+  rle::view view(data, sizeof(data));
+  std::vector<rle::run> runs(view.runs().begin(), view.runs().end());
+
+  ASSERT_EQ(2u, runs.size());
+  ASSERT_EQ(65, runs[0].value);
+  ASSERT_EQ(137u, runs[0].length);
+  ASSERT_EQ(66, runs[1].value);
+  ASSERT_EQ(5u, runs[1].length);
+}
+
+TEST(rleView, runIteratorReturnsRunsByValue) {
+  using traits = std::iterator_traits<rle::view::run_iterator>;
+  ASSERT_TRUE((std::is_same<std::input_iterator_tag,
+                            traits::iterator_category>::value));
+  ASSERT_TRUE((std::is_same<rle::run,
+                            decltype(*rle::view::run_iterator())>::value));
+
+  uint8_t data[] = {3, 65, 2, 66};
+  rle::view view(data, sizeof(data));
+  rle::view::run_iterator it = view.runs().begin();
+  rle::run first = *it++;
+
+  ASSERT_EQ(65, first.value);
+  ASSERT_EQ(3u, first.length);
+  ASSERT_EQ(66, (*it).value);
+  ASSERT_EQ(2u, (*it).length);
+}
+
+TEST(rleView, malformedTokenEndsData) {
+  uint8_t data[] = {2, 65, 0, 66, 3, 67};
+  rle::view view(data, sizeof(data));
+
+  std::vector<uint8_t> decoded(view.begin(), view.end());
+
+  ASSERT_EQ(std::vector<uint8_t>({65, 65}), decoded);
+}
+
+TEST(rleView, matchesDecode) {
+  std::vector<uint8_t> input;
+  for (int i = 0; i < 3000; ++i) {
+    input.insert(input.end(), 1 + (i * 7) % 5, (uint8_t)(i % 251));
+  }
+  RLE_Data encoded = {NULL, 0};
+  ASSERT_EQ(RLE_OK, RLE_encode(input.data(), input.size(), &encoded));
+  rle::view view(encoded);
+
+  ASSERT_TRUE(std::equal(input.begin(), input.end(), view.begin()));
+  ASSERT_EQ((std::ptrdiff_t)input.size(),
+            std::distance(view.begin(), view.end()));
+
+  std::size_t total = 0;
+  for (const rle::run &r : view.runs()) {
+    total += r.length;
+  }
+  ASSERT_EQ(input.size(), total);
+  free(encoded.data);
+}
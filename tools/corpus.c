@@ -0,0 +1,237 @@
+/*!
+ * \file    corpus.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Implementation of the synthetic corpus generator.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "corpus.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/*! Scale of 53 random bits to a double in [0, 1). */
+#define DOUBLE_SCALE (1.0 / 9007199254740992.0)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function declarations ---------------------------------------------*/
+static bool validOptions(const CorpusOptions *options);
+static uint64_t nextRandom(Corpus *corpus);
+static double nextDouble(Corpus *corpus);
+static uint32_t nextLength(Corpus *corpus);
+static uint8_t nextValue(Corpus *corpus);
+static uint32_t maxLength(const CorpusOptions *options);
+
+/* Exported functions definitions --------------------------------------------*/
+CorpusOptions CORPUS_default_options(uint64_t seed) {
+  CorpusOptions options;
+
+  options.seed = seed;
+  options.distribution = CORPUS_GEOMETRIC;
+  options.mean = 8.0;
+  options.exponent = 1.0;
+  options.maxLength = 0;
+  options.literals = 0.0;
+  options.alphabet = 256;
+
+  return options;
+}
+
+bool CORPUS_init(Corpus *corpus, const CorpusOptions *options) {
+  if (corpus == NULL || options == NULL || !validOptions(options)) {
+    return false;
+  }
+
+  corpus->options = *options;
+  corpus->random = options->seed;
+  corpus->zipf = NULL;
+  corpus->previous = -1;
+  corpus->left = 0;
+  corpus->literal = false;
+
+  if (options->distribution == CORPUS_ZIPF) {
+    uint32_t max = maxLength(options);
+    corpus->zipf = malloc(max * sizeof(double));
+    if (corpus->zipf == NULL) {
+      return false;
+    }
+
+    double sum = 0.0;
+    for (uint32_t k = 0; k < max; k++) {
+      sum += pow(k + 1, -options->exponent);
+      corpus->zipf[k] = sum;
+    }
+    for (uint32_t k = 0; k < max; k++) {
+      corpus->zipf[k] /= sum;
+    }
+  }
+
+  return true;
+}
+
+void CORPUS_fill(Corpus *corpus, uint8_t *out, uint32_t size) {
+  uint32_t pos = 0;
+
+  while (pos < size) {
+    if (corpus->left == 0) {
+      corpus->literal = nextDouble(corpus) < corpus->options.literals;
+      corpus->left = nextLength(corpus);
+      if (!corpus->literal) {
+        corpus->previous = nextValue(corpus);
+      }
+    }
+
+    uint32_t n = size - pos < corpus->left ? size - pos : corpus->left;
+    if (corpus->literal) {
+      for (uint32_t k = 0; k < n; k++) {
+        out[pos + k] = nextValue(corpus);
+        corpus->previous = out[pos + k];
+      }
+    } else {
+      memset(&out[pos], corpus->previous, n);
+    }
+    corpus->left -= n;
+    pos += n;
+  }
+}
+
+void CORPUS_free(Corpus *corpus) {
+  if (corpus != NULL) {
+    free(corpus->zipf);
+    corpus->zipf = NULL;
+  }
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Checks ranges of the options.
+ *
+ * \param[in]   options   Options of the generated data.
+ *
+ * \return Returns true if the options are valid.
+ */
+static bool validOptions(const CorpusOptions *options) {
+  switch (options->distribution) {
+    case CORPUS_FIXED:
+    case CORPUS_GEOMETRIC:
+      if (!(options->mean >= 1.0 && options->mean <= maxLength(options))) {
+        return false;
+      }
+      break;
+    case CORPUS_ZIPF:
+      if (!(options->exponent > 0.0)) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+
+  return options->literals >= 0.0 && options->literals <= 1.0 &&
+         options->alphabet >= 1 && options->alphabet <= 256;
+}
+
+/*! Returns the next value of the splitmix64 generator, which produces the
+ * same sequence on every platform.
+ *
+ * \param[in,out] corpus  Generator state.
+ *
+ * \return Pseudo-random 64-bit value.
+ */
+static uint64_t nextRandom(Corpus *corpus) {
+  uint64_t z = (corpus->random += 0x9E3779B97F4A7C15ull);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/*! Returns the next pseudo-random number in [0, 1).
+ *
+ * \param[in,out] corpus  Generator state.
+ *
+ * \return Pseudo-random number.
+ */
+static double nextDouble(Corpus *corpus) {
+  return (double)(nextRandom(corpus) >> 11) * DOUBLE_SCALE;
+}
+
+/*! Draws the length of the next run or literal.
+ *
+ * \param[in,out] corpus  Generator state.
+ *
+ * \return Length from 1 to the maximal length.
+ */
+static uint32_t nextLength(Corpus *corpus) {
+  const CorpusOptions *options = &corpus->options;
+  uint32_t max = maxLength(options);
+  double length;
+
+  switch (options->distribution) {
+    case CORPUS_FIXED:
+      length = options->mean;
+      break;
+    case CORPUS_GEOMETRIC:
+      // inverse of the distribution function with success probability 1/mean
+      length = options->mean <= 1.0
+                   ? 1.0
+                   : 1.0 + floor(log(1.0 - nextDouble(corpus)) /
+                                 log(1.0 - 1.0 / options->mean));
+      break;
+    default: {
+      double u = nextDouble(corpus);
+      uint32_t low = 0;
+      uint32_t high = max - 1;
+      while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (corpus->zipf[mid] <= u) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      length = low + 1;
+      break;
+    }
+  }
+
+  return length > max ? max : (uint32_t)length;
+}
+
+/*! Draws a byte value of the alphabet, which differs from the previous byte
+ * unless the alphabet has one value only.
+ *
+ * \param[in,out] corpus  Generator state.
+ *
+ * \return Byte value.
+ */
+static uint8_t nextValue(Corpus *corpus) {
+  uint32_t alphabet = corpus->options.alphabet;
+
+  if (corpus->previous < 0 || alphabet == 1) {
+    return (uint8_t)(nextRandom(corpus) % alphabet);
+  }
+
+  uint32_t value = (uint32_t)(nextRandom(corpus) % (alphabet - 1));
+  return (uint8_t)(value >= (uint32_t)corpus->previous ? value + 1 : value);
+}
+
+/*! Returns the maximal length of runs and literals.
+ *
+ * \param[in]   options   Options of the generated data.
+ *
+ * \return Maximal length.
+ */
+static uint32_t maxLength(const CorpusOptions *options) {
+  return options->maxLength == 0 ? CORPUS_MAX_LENGTH : options->maxLength;
+}
@@ -0,0 +1,105 @@
+/*!
+ * \file    corpus.h
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Declaration of the synthetic corpus generator.
+ *
+ * \defgroup CORPUS  Synthetic corpus
+ *
+ * The generator produces data of any size made of runs and literals, whose
+ * lengths follow the selected distribution. Adjacent runs and literal bytes
+ * always differ, so each generated run has exactly the drawn length. The
+ * generator uses its own pseudo-random generator, the same options produce
+ * the same data on every platform and for any split into chunks.
+ *
+ * Useful adversarial patterns:
+ * - alternating bytes - fixed length 1 and alphabet of 2 values,
+ * - runs longer than a run token - fixed length 128 or 256,
+ * - random data - fixed length 1 and alphabet of 256 values.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * \{
+ */
+#ifndef CORPUS_H
+#define CORPUS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/*! Distribution of the run and literal lengths. */
+typedef enum {
+  CORPUS_FIXED,     /*!< Every length is \ref CorpusOptions.mean. */
+  CORPUS_GEOMETRIC, /*!< Geometric distribution with the mean length. */
+  CORPUS_ZIPF       /*!< Zipf distribution with the exponent. */
+} CorpusDistribution;
+
+/*! Options of the generated data. */
+typedef struct {
+  uint64_t seed;                   /*!< Seed of the pseudo-random generator. */
+  CorpusDistribution distribution; /*!< Distribution of the lengths. */
+  double mean;                     /*!< Fixed or mean length, at least 1. */
+  double exponent;                 /*!< Exponent of Zipf distribution. */
+  uint32_t maxLength;              /*!< Maximal length, zero for 65536. */
+  double literals;   /*!< Probability of a literal instead of a run. */
+  uint16_t alphabet; /*!< Number of used byte values, 1 to 256. */
+} CorpusOptions;
+
+/*! State of the generator. */
+typedef struct {
+  CorpusOptions options; /*!< Options of the generated data. */
+  uint64_t random;       /*!< State of the pseudo-random generator. */
+  double *zipf;          /*!< Cumulative distribution of Zipf lengths. */
+  int previous;          /*!< Last generated byte, -1 before the first one. */
+  uint32_t left;         /*!< Bytes left in the current run or literal. */
+  bool literal;          /*!< True if the current segment is a literal. */
+} Corpus;
+
+/* Exported constants --------------------------------------------------------*/
+/*! Maximal length used if \ref CorpusOptions.maxLength is zero. */
+#define CORPUS_MAX_LENGTH (65536u)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions declarations -------------------------------------------*/
+
+/*! Returns the default options, geometric runs with mean length 8, no
+ * literals and the full alphabet.
+ *
+ * \param[in]   seed      Seed of the pseudo-random generator.
+ *
+ * \return Default options.
+ */
+CorpusOptions CORPUS_default_options(uint64_t seed);
+
+/*! Initializes the generator.
+ *
+ * \param[out]  corpus    Generator state.
+ * \param[in]   options   Options of the generated data.
+ *
+ * \return Returns false if the options are invalid or allocation failed.
+ */
+bool CORPUS_init(Corpus *corpus, const CorpusOptions *options);
+
+/*! Generates the next \a size bytes of the data.
+ *
+ * \param[in,out] corpus  Generator state.
+ * \param[out]    out     Output buffer.
+ * \param[in]     size    Number of generated bytes.
+ */
+void CORPUS_fill(Corpus *corpus, uint8_t *out, uint32_t size);
+
+/*! Releases memory of the generator.
+ *
+ * \param[in,out] corpus  Generator state.
+ */
+void CORPUS_free(Corpus *corpus);
+
+/*! \} */
+#endif  // CORPUS_H
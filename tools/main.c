@@ -0,0 +1,342 @@
+/*!
+ * \file    main.c
+ * \author  Tomas Jurena
+ * \date    19. 10. 2026
+ * \brief   Command line tool generating synthetic corpus files.
+ *
+ * \attention
+ * &copy; Copyright (c) 2021 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <assert.h>  /* assert */
+#include <stdbool.h> /* true, false */
+#include <stdint.h>  /* uint8_t, uint32_t, uint64_t */
+#include <stdio.h>   /* FILE, fopen, fwrite, fprintf, ... */
+#include <stdlib.h>  /* malloc, strtod, strtoull, EXIT_SUCCESS */
+#include <string.h>  /* strcmp, strncmp */
+
+#include "corpus.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/*! The Config struct contains information about current run configuration based
+ * on commandline arguments.
+ */
+struct Config {
+  /*! Path to output file. */
+  char* outputFileName;
+
+  /*! Size of generated data in bytes. */
+  uint64_t size;
+
+  /*! Options of the generated data. */
+  CorpusOptions options;
+};
+
+/* Private macro -------------------------------------------------------------*/
+/*! \defgroup EXIT_CODES Exit codes
+ *  List of program non-standard exit codes.
+ *  \{
+ */
+
+/*! The program arrguments were not parsed correctly. */
+#define EXIT_FAILURE_ARGUMENTS (2)
+
+/*! Some file (input/output) was not opened. */
+#define EXIT_FAILURE_FILE (3)
+
+/*! The program was unable to allocate necessary memory. */
+#define EXIT_FAILURE_MEMORY (4)
+
+/*! \}*/
+
+/*! Size of the chunks written to the output file. */
+#define CHUNK_SIZE (1u << 16)
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Private function declarations ---------------------------------------------*/
+static bool parseArgs(int argc, char** argv, struct Config* cfg);
+static bool parseOption(const char* name, const char* value,
+                        CorpusOptions* options);
+static bool parseDistribution(const char* text, CorpusOptions* options);
+static bool parsePattern(const char* text, CorpusOptions* options);
+static bool parseNumber(const char* text, double min, double max,
+                        double* number);
+static bool parseSize(const char* text, uint64_t* size);
+static void printHelp(char* bin);
+
+/* Exported functions definitions --------------------------------------------*/
+int main(int argc, char** argv) {
+  int programResult = EXIT_SUCCESS;
+  struct Config cfg;
+  Corpus corpus;
+  uint8_t* chunk = NULL;
+  FILE* of = NULL;
+
+  if (!parseArgs(argc, argv, &cfg)) {
+    programResult = EXIT_FAILURE_ARGUMENTS;
+    goto exit;
+  }
+
+  chunk = malloc(CHUNK_SIZE);
+  if (chunk == NULL) {
+    programResult = EXIT_FAILURE_MEMORY;
+    goto exit;
+  }
+
+  if (!CORPUS_init(&corpus, &cfg.options)) {
+    fputs("Wrong options or not enough memory\n", stderr);
+    programResult = EXIT_FAILURE_ARGUMENTS;
+    goto exit;
+  }
+
+  of = fopen(cfg.outputFileName, "wb");
+  if (of == NULL) {
+    programResult = EXIT_FAILURE_FILE;
+    goto exit_corpus;
+  }
+
+  for (uint64_t done = 0; done < cfg.size;) {
+    uint32_t n = cfg.size - done < CHUNK_SIZE ? (uint32_t)(cfg.size - done)
+                                              : CHUNK_SIZE;
+    CORPUS_fill(&corpus, chunk, n);
+    if (fwrite(chunk, 1, n, of) != n) {
+      programResult = EXIT_FAILURE_FILE;
+      break;
+    }
+    done += n;
+  }
+
+  if (fclose(of) != 0 || programResult != EXIT_SUCCESS) {
+    fputs("Error while writing the output file\n", stderr);
+    remove(cfg.outputFileName);
+    programResult = EXIT_FAILURE_FILE;
+  }
+
+exit_corpus:
+  CORPUS_free(&corpus);
+exit:
+  free(chunk);
+  return programResult;
+}
+
+/* Private function definitions ----------------------------------------------*/
+/*! Parse commandline arguments and store the information to the cfg structure.
+ *
+ * \param[in]  argc  Number of arguments.
+ * \param[in]  argv  Array of arguments.
+ * \param[out] cfg   Pointer to structure where parsed configuration will be
+ * stored.
+ *
+ * \return Returns true if arguments are valid, false otherwise.
+ */
+static bool parseArgs(int argc, char** argv, struct Config* cfg) {
+  assert(argv != NULL);
+  assert(cfg != NULL);
+  char* bin = argv[0];
+
+  cfg->options = CORPUS_default_options(0);
+  while (argc > 4 && strncmp(argv[1], "--", 2) == 0) {
+    if (!parseOption(argv[1], argv[2], &cfg->options)) {
+      fprintf(stderr, "Wrong option '%s %s'\n", argv[1], argv[2]);
+      printHelp(bin);
+      return false;
+    }
+    argc -= 2;
+    argv += 2;
+  }
+
+  if (argc != 3) {
+    printHelp(bin);
+    return false;
+  }
+
+  if (!parseSize(argv[1], &cfg->size)) {
+    fprintf(stderr, "Wrong size '%s'\n", argv[1]);
+    printHelp(bin);
+    return false;
+  }
+  cfg->outputFileName = argv[2];
+
+  return true;
+}
+
+/*! Parses one option with its value.
+ *
+ * \param[in]     name     Name of the option.
+ * \param[in]     value    Value of the option.
+ * \param[in,out] options  Options of the generated data.
+ *
+ * \return Returns true if the option is valid, false otherwise.
+ */
+static bool parseOption(const char* name, const char* value,
+                        CorpusOptions* options) {
+  double number;
+
+  if (strcmp(name, "--seed") == 0) {
+    return parseSize(value, &options->seed);
+  } else if (strcmp(name, "--runs") == 0) {
+    return parseDistribution(value, options);
+  } else if (strcmp(name, "--pattern") == 0) {
+    return parsePattern(value, options);
+  } else if (strcmp(name, "--max-length") == 0) {
+    if (!parseNumber(value, 1, CORPUS_MAX_LENGTH, &number)) {
+      return false;
+    }
+    options->maxLength = (uint32_t)number;
+  } else if (strcmp(name, "--literals") == 0) {
+    return parseNumber(value, 0.0, 1.0, &options->literals);
+  } else if (strcmp(name, "--alphabet") == 0) {
+    if (!parseNumber(value, 1, 256, &number)) {
+      return false;
+    }
+    options->alphabet = (uint16_t)number;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+/*! Parses the distribution of the lengths in the form fixed:<length>,
+ * geometric:<mean> or zipf:<exponent>.
+ *
+ * \param[in]     text     Parsed text.
+ * \param[in,out] options  Options of the generated data.
+ *
+ * \return Returns true if the distribution is valid, false otherwise.
+ */
+static bool parseDistribution(const char* text, CorpusOptions* options) {
+  if (strncmp(text, "fixed:", 6) == 0) {
+    options->distribution = CORPUS_FIXED;
+    return parseNumber(&text[6], 1, CORPUS_MAX_LENGTH, &options->mean);
+  } else if (strncmp(text, "geometric:", 10) == 0) {
+    options->distribution = CORPUS_GEOMETRIC;
+    return parseNumber(&text[10], 1, CORPUS_MAX_LENGTH, &options->mean);
+  } else if (strncmp(text, "zipf:", 5) == 0) {
+    options->distribution = CORPUS_ZIPF;
+    return parseNumber(&text[5], 0.01, 100, &options->exponent);
+  }
+
+  return false;
+}
+
+/*! Parses the name of an adversarial pattern and sets the options producing
+ * it.
+ *
+ * \param[in]     text     Parsed text.
+ * \param[in,out] options  Options of the generated data.
+ *
+ * \return Returns true if the pattern is known, false otherwise.
+ */
+static bool parsePattern(const char* text, CorpusOptions* options) {
+  options->distribution = CORPUS_FIXED;
+  options->literals = 0.0;
+  options->alphabet = 256;
+
+  if (strcmp(text, "alternating") == 0) {
+    options->mean = 1;
+    options->alphabet = 2;
+  } else if (strcmp(text, "runs-128") == 0) {
+    options->mean = 128;
+  } else if (strcmp(text, "runs-256") == 0) {
+    options->mean = 256;
+  } else if (strcmp(text, "random") == 0) {
+    options->mean = 1;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+/*! Parses a number within the range.
+ *
+ * \param[in]  text    Parsed text.
+ * \param[in]  min     Minimal value.
+ * \param[in]  max     Maximal value.
+ * \param[out] number  Parsed number.
+ *
+ * \return Returns true if the text is a valid number, false otherwise.
+ */
+static bool parseNumber(const char* text, double min, double max,
+                        double* number) {
+  char* end;
+  double value = strtod(text, &end);
+
+  if (end == text || *end != '\0' || !(value >= min && value <= max)) {
+    return false;
+  }
+
+  *number = value;
+  return true;
+}
+
+/*! Parses the size in bytes with optional K, M or G suffix.
+ *
+ * \param[in]  text  Parsed text.
+ * \param[out] size  Parsed size.
+ *
+ * \return Returns true if the text is a valid size, false otherwise.
+ */
+static bool parseSize(const char* text, uint64_t* size) {
+  char* end;
+  unsigned long long value = strtoull(text, &end, 10);
+  unsigned shift = 0;
+
+  if (end == text || text[0] == '-') {
+    return false;
+  }
+
+  switch (*end) {
+    case 'K':
+      shift = 10;
+      break;
+    case 'M':
+      shift = 20;
+      break;
+    case 'G':
+      shift = 30;
+      break;
+    case '\0':
+      break;
+    default:
+      return false;
+  }
+  if (shift != 0 && *++end != '\0') {
+    return false;
+  }
+  if (value > UINT64_MAX >> shift) {
+    return false;
+  }
+
+  *size = (uint64_t)value << shift;
+  return true;
+}
+
+/*! Writes help message to stderr.
+ *
+ * \param[in] bin Path to current binary. Used for effective call generation.
+ */
+static void printHelp(char* bin) {
+  assert(bin != NULL);
+  fprintf(stderr,
+          "Wrong call\n"
+          "Usage %s [options] <size> <output file>\n"
+          "\tsize: size in bytes, K, M or G suffix allowed\n"
+          "\toptions:\n"
+          "\t\t--seed <n>          - seed of the generator, 0 by default\n"
+          "\t\t--runs <dist>       - distribution of lengths:\n"
+          "\t\t                      fixed:<length>, geometric:<mean>\n"
+          "\t\t                      or zipf:<exponent>, geometric:8\n"
+          "\t\t                      by default\n"
+          "\t\t--max-length <n>    - maximal length, 65536 by default\n"
+          "\t\t--literals <p>      - probability of a literal, 0 to 1\n"
+          "\t\t--alphabet <n>      - number of byte values, 1 to 256\n"
+          "\t\t--pattern <name>    - adversarial pattern: alternating,\n"
+          "\t\t                      runs-128, runs-256 or random\n",
+          bin);
+}